@@ -1,20 +1,29 @@
 from setuptools import setup, Extension
 
+import os
 import platform
 
 compile_args = ['-std=c11', '-O3', '-Wall', '-Wextra']
 if platform.machine() in ['x86_64', 'AMD64', 'i686', 'i386']:
     compile_args.extend(['-mavx2', '-msse4.2', '-mpopcnt'])
+if os.environ.get('CJSON_STATS'):
+    compile_args.append('-DCJSON_STATS')
 
 module = Extension(
     'cjson',
     sources=[
         './src/python_bindings.c',
         './src/json_parser.c',
+        './src/json_arena.c',
+        './src/json_parallel.c',
+        './src/json_number.c',
         './src/json_stringify.c',
         './src/json_converters.c',
         './src/json_utils.c',
         './src/json_file_io.c',
+        './src/json_binary.c',
+        './src/json_doc.c',
+        './src/json_columnar.c',
         './src/json_to_parsers.c',
         './src/json_sqlite.c',
         './src/json_advanced.c',
@@ -24,7 +33,7 @@ module = Extension(
     include_dirs=['./src'],
     libraries=['sqlite3'],
     extra_compile_args=compile_args,
-    extra_link_args=['-lm']
+    extra_link_args=['-lm', '-lpthread']
 )
 
 setup(
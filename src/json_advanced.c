@@ -50,13 +50,13 @@ static bool path_matches_filter(const JsonValue* item, const char* filter) {
     
     if (strcmp(op, "==") == 0) {
         if (field->type == JSON_STRING) {
-            result = strcmp(field->data.string_value, value_str) == 0;
+            result = strcmp(json_string_value(field), value_str) == 0;
         } else if (field->type == JSON_NUMBER) {
             result = field->data.number_value == atof(value_str);
         }
     } else if (strcmp(op, "!=") == 0) {
         if (field->type == JSON_STRING) {
-            result = strcmp(field->data.string_value, value_str) != 0;
+            result = strcmp(json_string_value(field), value_str) != 0;
         } else if (field->type == JSON_NUMBER) {
             result = field->data.number_value != atof(value_str);
         }
@@ -66,112 +66,134 @@ static bool path_matches_filter(const JsonValue* item, const char* filter) {
     return result;
 }
 
-JsonValue* json_path_query(const JsonValue* root, const char* path) {
-    if (!root) {
-        json_set_error(JSON_ERROR_NULL_POINTER, "Root value is NULL", 0, 0);
-        return NULL;
+// Compiled JSONPath: the path string is parsed once into a step
+// sequence that can be executed against any number of documents.
+// Execution walks the tree by reference and only deep-copies at the
+// end (or when a step synthesizes a new array), unlike the old
+// interpreter which copied the entire root up front on every call.
+
+typedef enum {
+    PATH_STEP_KEY,
+    PATH_STEP_WILDCARD,
+    PATH_STEP_INDEX,
+    PATH_STEP_SLICE,
+    PATH_STEP_FILTER
+} PathStepType;
+
+typedef struct {
+    PathStepType type;
+    char* key;
+    char* filter;
+    int start;
+    int end;
+} PathStep;
+
+struct JsonPathExpr {
+    PathStep* steps;
+    size_t count;
+    size_t capacity;
+};
+
+static PathStep* path_expr_add_step(JsonPathExpr* expr, PathStepType type) {
+    if (expr->count >= expr->capacity) {
+        size_t new_capacity = expr->capacity == 0 ? 8 : expr->capacity * 2;
+        PathStep* fresh = realloc(expr->steps, new_capacity * sizeof(PathStep));
+        if (!fresh) return NULL;
+        expr->steps = fresh;
+        expr->capacity = new_capacity;
     }
-    
+
+    PathStep* step = &expr->steps[expr->count++];
+    step->type = type;
+    step->key = NULL;
+    step->filter = NULL;
+    step->start = 0;
+    step->end = -1;
+    return step;
+}
+
+void json_path_expr_free(JsonPathExpr* expr) {
+    if (!expr) return;
+    for (size_t i = 0; i < expr->count; i++) {
+        free(expr->steps[i].key);
+        free(expr->steps[i].filter);
+    }
+    free(expr->steps);
+    free(expr);
+}
+
+JsonPathExpr* json_path_compile(const char* path) {
     if (!path) {
         json_set_error(JSON_ERROR_NULL_POINTER, "Path is NULL", 0, 0);
         return NULL;
     }
-    
+
     size_t path_len = strlen(path);
     if (path_len == 0) {
         json_set_error(JSON_ERROR_INVALID_SYNTAX, "Path is empty", 0, 0);
         return NULL;
     }
-    
+
     if (path_len > 10000) {  // Prevent DoS with very long paths
         json_set_error(JSON_ERROR_INVALID_SYNTAX, "Path too long (>10000 chars)", 0, 0);
         return NULL;
     }
-    
+
     if (*path != '$') {
         json_set_error(JSON_ERROR_INVALID_SYNTAX, "Path must start with '$'", 0, 0);
         return NULL;
     }
-    
-    JsonValue* current = json_deep_copy(root);
-    if (!current) {
-        json_set_error(JSON_ERROR_OUT_OF_MEMORY, "Failed to copy root for path query", 0, 0);
+
+    JsonPathExpr* expr = calloc(1, sizeof(JsonPathExpr));
+    if (!expr) {
+        json_set_error(JSON_ERROR_OUT_OF_MEMORY, "Failed to allocate path expression", 0, 0);
         return NULL;
     }
-    
+
     const char* ptr = path + 1;
-    
-    while (*ptr && current) {
+
+    while (*ptr) {
         if (*ptr == '.') {
             ptr++;
-            
-            // Handle double dot (recursive descent)
+
+            // Recursive descent - simplified implementation (no-op,
+            // matching the behavior of the old interpreter)
             if (*ptr == '.') {
                 ptr++;
-                // Recursive descent - simplified implementation
                 continue;
             }
-            
-            // Handle wildcard
+
             if (*ptr == '*') {
                 ptr++;
-                if (current->type == JSON_OBJECT) {
-                    // Return all values as array
-                    JsonValue* result = json_create_array();
-                    JsonObject* obj = current->data.object_value;
-                    for (size_t i = 0; i < obj->count; i++) {
-                        json_array_append(result, json_deep_copy(obj->pairs[i].value));
-                    }
-                    json_free(current);
-                    current = result;
-                } else if (current->type == JSON_ARRAY) {
-                    // Already an array, keep as is
-                }
+                if (!path_expr_add_step(expr, PATH_STEP_WILDCARD)) goto oom;
                 continue;
             }
-            
+
             const char* start = ptr;
             while (*ptr && *ptr != '.' && *ptr != '[') ptr++;
-            
+
             size_t len = ptr - start;
-            char* key = malloc(len + 1);
-            strncpy(key, start, len);
-            key[len] = '\0';
-            
-            if (current->type == JSON_OBJECT) {
-                JsonValue* next = json_object_get(current, key);
-                if (next) {
-                    JsonValue* copied = json_deep_copy(next);
-                    json_free(current);
-                    current = copied;
-                } else {
-                    free(key);
-                    json_free(current);
-                    return NULL;
-                }
-            } else {
-                free(key);
-                json_free(current);
-                return NULL;
-            }
-            free(key);
-            
+            PathStep* step = path_expr_add_step(expr, PATH_STEP_KEY);
+            if (!step) goto oom;
+            step->key = malloc(len + 1);
+            if (!step->key) goto oom;
+            memcpy(step->key, start, len);
+            step->key[len] = '\0';
+
         } else if (*ptr == '[') {
             ptr++;
-            
-            // Handle wildcard in array
+
+            // [*] keeps an array as-is; no step needed
             if (*ptr == '*') {
-                ptr++;
                 while (*ptr && *ptr != ']') ptr++;
                 if (*ptr == ']') ptr++;
                 continue;
             }
-            
-            // Handle filter expression
+
             if (*ptr == '?') {
                 ptr++;
                 if (*ptr == '(') ptr++;
-                
+
                 const char* filter_start = ptr;
                 int paren_depth = 1;
                 while (*ptr && paren_depth > 0) {
@@ -179,41 +201,28 @@ JsonValue* json_path_query(const JsonValue* root, const char* path) {
                     if (*ptr == ')') paren_depth--;
                     ptr++;
                 }
-                
+
                 size_t filter_len = ptr - filter_start - 1;
-                char* filter = malloc(filter_len + 1);
-                strncpy(filter, filter_start, filter_len);
-                filter[filter_len] = '\0';
-                
-                if (current->type == JSON_ARRAY) {
-                    JsonValue* filtered = json_create_array();
-                    JsonArray* arr = current->data.array_value;
-                    
-                    for (size_t i = 0; i < arr->count; i++) {
-                        if (path_matches_filter(arr->values[i], filter)) {
-                            json_array_append(filtered, json_deep_copy(arr->values[i]));
-                        }
-                    }
-                    
-                    json_free(current);
-                    current = filtered;
-                }
-                
-                free(filter);
+                PathStep* step = path_expr_add_step(expr, PATH_STEP_FILTER);
+                if (!step) goto oom;
+                step->filter = malloc(filter_len + 1);
+                if (!step->filter) goto oom;
+                memcpy(step->filter, filter_start, filter_len);
+                step->filter[filter_len] = '\0';
+
                 while (*ptr && *ptr != ']') ptr++;
                 if (*ptr == ']') ptr++;
                 continue;
             }
-            
-            // Handle array index or slice
+
             int start_idx = 0, end_idx = -1;
             bool is_slice = false;
-            
+
             if (*ptr == '-' || isdigit(*ptr)) {
                 start_idx = atoi(ptr);
                 while (*ptr && (*ptr == '-' || isdigit(*ptr))) ptr++;
             }
-            
+
             if (*ptr == ':') {
                 is_slice = true;
                 ptr++;
@@ -222,45 +231,461 @@ JsonValue* json_path_query(const JsonValue* root, const char* path) {
                     while (*ptr && (*ptr == '-' || isdigit(*ptr))) ptr++;
                 }
             }
-            
+
             while (*ptr && *ptr != ']') ptr++;
             if (*ptr == ']') ptr++;
-            
-            if (current->type == JSON_ARRAY) {
+
+            PathStep* step = path_expr_add_step(expr, is_slice ? PATH_STEP_SLICE : PATH_STEP_INDEX);
+            if (!step) goto oom;
+            step->start = start_idx;
+            step->end = end_idx;
+        } else {
+            ptr++;
+        }
+    }
+
+    return expr;
+
+oom:
+    json_path_expr_free(expr);
+    json_set_error(JSON_ERROR_OUT_OF_MEMORY, "Failed to compile path expression", 0, 0);
+    return NULL;
+}
+
+JsonValue* json_path_exec(const JsonPathExpr* expr, const JsonValue* root) {
+    if (!expr || !root) {
+        json_set_error(JSON_ERROR_NULL_POINTER, "Expression or root is NULL", 0, 0);
+        return NULL;
+    }
+
+    // The cursor either borrows a node inside the caller's tree or owns
+    // a synthetic value built by a wildcard/slice/filter step
+    const JsonValue* borrowed = root;
+    JsonValue* owned = NULL;
+
+    for (size_t s = 0; s < expr->count; s++) {
+        const PathStep* step = &expr->steps[s];
+        const JsonValue* current = owned ? owned : borrowed;
+
+        switch (step->type) {
+            case PATH_STEP_KEY: {
+                if (current->type != JSON_OBJECT) goto miss;
+                JsonValue* next = json_object_get((JsonValue*)current, step->key);
+                if (!next) goto miss;
+                if (owned) {
+                    JsonValue* copy = json_deep_copy(next);
+                    json_free(owned);
+                    owned = copy;
+                    if (!owned) goto miss;
+                } else {
+                    borrowed = next;
+                }
+                break;
+            }
+
+            case PATH_STEP_WILDCARD: {
+                if (current->type != JSON_OBJECT) break;
+                JsonValue* result = json_create_array();
+                if (!result) goto miss;
+                JsonObject* obj = current->data.object_value;
+                for (size_t i = 0; i < obj->count; i++) {
+                    json_array_append(result, json_deep_copy(obj->pairs[i].value));
+                }
+                json_free(owned);
+                owned = result;
+                break;
+            }
+
+            case PATH_STEP_INDEX: {
+                if (current->type != JSON_ARRAY) goto miss;
                 JsonArray* arr = current->data.array_value;
-                
-                if (is_slice) {
-                    JsonValue* sliced = json_create_array();
-                    int actual_end = end_idx < 0 ? arr->count : end_idx;
-                    
-                    for (int i = start_idx; i < actual_end && i < (int)arr->count; i++) {
-                        json_array_append(sliced, json_deep_copy(arr->values[i]));
-                    }
-                    
-                    json_free(current);
-                    current = sliced;
+                int idx = step->start;
+                if (idx < 0) idx = (int)arr->count + idx;
+                JsonValue* item = json_array_get((JsonValue*)current, idx);
+                if (!item) goto miss;
+                if (owned) {
+                    JsonValue* copy = json_deep_copy(item);
+                    json_free(owned);
+                    owned = copy;
+                    if (!owned) goto miss;
                 } else {
-                    if (start_idx < 0) start_idx = arr->count + start_idx;
-                    JsonValue* item = json_array_get(current, start_idx);
-                    if (item) {
-                        JsonValue* copied = json_deep_copy(item);
-                        json_free(current);
-                        current = copied;
-                    } else {
-                        json_free(current);
-                        return NULL;
+                    borrowed = item;
+                }
+                break;
+            }
+
+            case PATH_STEP_SLICE: {
+                if (current->type != JSON_ARRAY) goto miss;
+                JsonArray* arr = current->data.array_value;
+                JsonValue* sliced = json_create_array();
+                if (!sliced) goto miss;
+                int actual_end = step->end < 0 ? (int)arr->count : step->end;
+                for (int i = step->start; i < actual_end && i < (int)arr->count; i++) {
+                    json_array_append(sliced, json_deep_copy(arr->values[i]));
+                }
+                json_free(owned);
+                owned = sliced;
+                break;
+            }
+
+            case PATH_STEP_FILTER: {
+                if (current->type != JSON_ARRAY) break;
+                JsonArray* arr = current->data.array_value;
+                JsonValue* filtered = json_create_array();
+                if (!filtered) goto miss;
+                for (size_t i = 0; i < arr->count; i++) {
+                    if (path_matches_filter(arr->values[i], step->filter)) {
+                        json_array_append(filtered, json_deep_copy(arr->values[i]));
                     }
                 }
-            } else {
-                json_free(current);
+                json_free(owned);
+                owned = filtered;
+                break;
+            }
+        }
+    }
+
+    return owned ? owned : json_deep_copy(borrowed);
+
+miss:
+    json_free(owned);
+    return NULL;
+}
+
+// Small LRU of compiled expressions so existing json_path_query callers
+// that evaluate the same handful of paths skip recompilation entirely.
+// Per-thread like the error slot: eviction frees the expression, so a
+// shared cache could pull one out from under a concurrent query.
+#define PATH_CACHE_SIZE 32
+
+typedef struct {
+    char* path;
+    JsonPathExpr* expr;
+    unsigned last_used;
+} CachedPath;
+
+static _Thread_local CachedPath g_path_cache[PATH_CACHE_SIZE];
+static _Thread_local unsigned g_path_cache_clock = 0;
+
+static JsonPathExpr* path_cache_fetch(const char* path) {
+    for (int i = 0; i < PATH_CACHE_SIZE; i++) {
+        if (g_path_cache[i].path && strcmp(g_path_cache[i].path, path) == 0) {
+            g_path_cache[i].last_used = ++g_path_cache_clock;
+            return g_path_cache[i].expr;
+        }
+    }
+
+    JsonPathExpr* expr = json_path_compile(path);
+    if (!expr) return NULL;
+
+    int slot = 0;
+    for (int i = 0; i < PATH_CACHE_SIZE; i++) {
+        if (!g_path_cache[i].expr) {
+            slot = i;
+            break;
+        }
+        if (g_path_cache[i].last_used < g_path_cache[slot].last_used) {
+            slot = i;
+        }
+    }
+
+    char* path_copy = malloc(strlen(path) + 1);
+    if (!path_copy) {
+        // Still usable this once; just don't cache it
+        return expr;
+    }
+    strcpy(path_copy, path);
+
+    if (g_path_cache[slot].expr) {
+        json_path_expr_free(g_path_cache[slot].expr);
+        free(g_path_cache[slot].path);
+    }
+    g_path_cache[slot].path = path_copy;
+    g_path_cache[slot].expr = expr;
+    g_path_cache[slot].last_used = ++g_path_cache_clock;
+    return expr;
+}
+
+JsonValue* json_path_query(const JsonValue* root, const char* path) {
+    if (!root) {
+        json_set_error(JSON_ERROR_NULL_POINTER, "Root value is NULL", 0, 0);
+        return NULL;
+    }
+
+    if (!path) {
+        json_set_error(JSON_ERROR_NULL_POINTER, "Path is NULL", 0, 0);
+        return NULL;
+    }
+
+    JsonPathExpr* expr = path_cache_fetch(path);
+    if (!expr) return NULL;
+
+    return json_path_exec(expr, root);
+}
+
+// Compiled schema validation: the schema tree is resolved once into a
+// flat structure (type mask, sorted property/required tables, numeric
+// bounds) so validating an event is pure table lookups with no repeated
+// interpretation of the schema JsonValue.
+
+typedef struct {
+    char* key;
+    JsonSchema* schema;
+} SchemaProperty;
+
+struct JsonSchema {
+    int type_mask;              // bit per JsonType; 0 = any type
+    SchemaProperty* properties; // sorted by key for binary search
+    size_t property_count;
+    char** required;            // sorted key list
+    size_t required_count;
+    JsonSchema* items;
+    double minimum;
+    double maximum;
+    bool has_minimum;
+    bool has_maximum;
+};
+
+void json_schema_free(JsonSchema* schema) {
+    if (!schema) return;
+    for (size_t i = 0; i < schema->property_count; i++) {
+        free(schema->properties[i].key);
+        json_schema_free(schema->properties[i].schema);
+    }
+    free(schema->properties);
+    for (size_t i = 0; i < schema->required_count; i++) {
+        free(schema->required[i]);
+    }
+    free(schema->required);
+    json_schema_free(schema->items);
+    free(schema);
+}
+
+static int schema_type_mask(const char* name) {
+    if (strcmp(name, "object") == 0) return 1 << JSON_OBJECT;
+    if (strcmp(name, "array") == 0) return 1 << JSON_ARRAY;
+    if (strcmp(name, "string") == 0) return 1 << JSON_STRING;
+    if (strcmp(name, "number") == 0) return 1 << JSON_NUMBER;
+    if (strcmp(name, "boolean") == 0) return 1 << JSON_BOOL;
+    if (strcmp(name, "null") == 0) return 1 << JSON_NULL;
+    return 0;
+}
+
+static int schema_property_cmp(const void* a, const void* b) {
+    return strcmp(((const SchemaProperty*)a)->key, ((const SchemaProperty*)b)->key);
+}
+
+static int schema_key_cmp(const void* a, const void* b) {
+    return strcmp(*(char* const*)a, *(char* const*)b);
+}
+
+JsonSchema* json_schema_compile(const JsonValue* schema) {
+    if (!schema) {
+        json_set_error(JSON_ERROR_NULL_POINTER, "Schema is NULL", 0, 0);
+        return NULL;
+    }
+
+    if (schema->type != JSON_OBJECT) {
+        json_set_error(JSON_ERROR_INVALID_TYPE, "Schema must be a JSON object", 0, 0);
+        return NULL;
+    }
+
+    JsonSchema* compiled = calloc(1, sizeof(JsonSchema));
+    if (!compiled) {
+        json_set_error(JSON_ERROR_OUT_OF_MEMORY, "Failed to allocate compiled schema", 0, 0);
+        return NULL;
+    }
+
+    JsonValue* type_val = json_object_get(schema, "type");
+    if (type_val && type_val->type == JSON_STRING) {
+        compiled->type_mask = schema_type_mask(json_string_value(type_val));
+    }
+
+    JsonValue* minimum = json_object_get(schema, "minimum");
+    if (minimum && minimum->type == JSON_NUMBER) {
+        compiled->minimum = minimum->data.number_value;
+        compiled->has_minimum = true;
+    }
+
+    JsonValue* maximum = json_object_get(schema, "maximum");
+    if (maximum && maximum->type == JSON_NUMBER) {
+        compiled->maximum = maximum->data.number_value;
+        compiled->has_maximum = true;
+    }
+
+    JsonValue* properties = json_object_get(schema, "properties");
+    if (properties && properties->type == JSON_OBJECT) {
+        JsonObject* props = properties->data.object_value;
+        compiled->properties = calloc(props->count, sizeof(SchemaProperty));
+        if (!compiled->properties) goto oom;
+
+        for (size_t i = 0; i < props->count; i++) {
+            JsonSchema* child = json_schema_compile(props->pairs[i].value);
+            if (!child) {
+                json_schema_free(compiled);
                 return NULL;
             }
-        } else {
-            ptr++;
+            char* key = malloc(strlen(props->pairs[i].key) + 1);
+            if (!key) {
+                json_schema_free(child);
+                goto oom;
+            }
+            strcpy(key, props->pairs[i].key);
+            compiled->properties[compiled->property_count].key = key;
+            compiled->properties[compiled->property_count].schema = child;
+            compiled->property_count++;
         }
+        qsort(compiled->properties, compiled->property_count,
+              sizeof(SchemaProperty), schema_property_cmp);
     }
-    
-    return current;
+
+    JsonValue* required = json_object_get(schema, "required");
+    if (required && required->type == JSON_ARRAY) {
+        JsonArray* req = required->data.array_value;
+        compiled->required = calloc(req->count, sizeof(char*));
+        if (!compiled->required) goto oom;
+
+        for (size_t i = 0; i < req->count; i++) {
+            if (req->values[i]->type != JSON_STRING) continue;
+            char* key = malloc(strlen(json_string_value(req->values[i])) + 1);
+            if (!key) goto oom;
+            strcpy(key, json_string_value(req->values[i]));
+            compiled->required[compiled->required_count++] = key;
+        }
+        qsort(compiled->required, compiled->required_count,
+              sizeof(char*), schema_key_cmp);
+    }
+
+    JsonValue* items = json_object_get(schema, "items");
+    if (items && items->type == JSON_OBJECT) {
+        compiled->items = json_schema_compile(items);
+        if (!compiled->items) {
+            json_schema_free(compiled);
+            return NULL;
+        }
+    }
+
+    return compiled;
+
+oom:
+    json_schema_free(compiled);
+    json_set_error(JSON_ERROR_OUT_OF_MEMORY, "Failed to compile schema", 0, 0);
+    return NULL;
+}
+
+static const JsonSchema* schema_find_property(const JsonSchema* schema, const char* key) {
+    size_t lo = 0, hi = schema->property_count;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        int cmp = strcmp(schema->properties[mid].key, key);
+        if (cmp == 0) return schema->properties[mid].schema;
+        if (cmp < 0) lo = mid + 1;
+        else hi = mid;
+    }
+    return NULL;
+}
+
+static const char* json_type_name(JsonType type) {
+    switch (type) {
+        case JSON_NULL: return "null";
+        case JSON_BOOL: return "boolean";
+        case JSON_NUMBER: return "number";
+        case JSON_STRING: return "string";
+        case JSON_ARRAY: return "array";
+        case JSON_OBJECT: return "object";
+    }
+    return "unknown";
+}
+
+static bool schema_fail(const char* path, const char* detail) {
+    char message[512];
+    snprintf(message, sizeof(message), "Schema violation at %s: %s",
+             path[0] ? path : "$", detail);
+    json_set_error(JSON_ERROR_INVALID_TYPE, message, 0, 0);
+    return false;
+}
+
+static bool schema_validate_node(const JsonSchema* schema, const JsonValue* data,
+                                 char* path, size_t path_len, size_t path_cap) {
+    if (schema->type_mask && !(schema->type_mask & (1 << data->type))) {
+        char detail[128];
+        snprintf(detail, sizeof(detail), "unexpected type %s", json_type_name(data->type));
+        return schema_fail(path, detail);
+    }
+
+    if (data->type == JSON_NUMBER) {
+        if (schema->has_minimum && data->data.number_value < schema->minimum) {
+            char detail[128];
+            snprintf(detail, sizeof(detail), "%g is below minimum %g",
+                     data->data.number_value, schema->minimum);
+            return schema_fail(path, detail);
+        }
+        if (schema->has_maximum && data->data.number_value > schema->maximum) {
+            char detail[128];
+            snprintf(detail, sizeof(detail), "%g is above maximum %g",
+                     data->data.number_value, schema->maximum);
+            return schema_fail(path, detail);
+        }
+    }
+
+    if (data->type == JSON_OBJECT) {
+        for (size_t i = 0; i < schema->required_count; i++) {
+            if (!json_object_has(data, schema->required[i])) {
+                char detail[300];
+                snprintf(detail, sizeof(detail), "missing required key \"%s\"",
+                         schema->required[i]);
+                return schema_fail(path, detail);
+            }
+        }
+
+        if (schema->property_count > 0) {
+            JsonObject* obj = data->data.object_value;
+            for (size_t i = 0; i < obj->count; i++) {
+                const JsonSchema* child = schema_find_property(schema, obj->pairs[i].key);
+                if (!child) continue;
+
+                size_t added = (size_t)snprintf(path + path_len, path_cap - path_len,
+                                                ".%s", obj->pairs[i].key);
+                if (added >= path_cap - path_len) added = path_cap - path_len - 1;
+                if (!schema_validate_node(child, obj->pairs[i].value,
+                                          path, path_len + added, path_cap)) {
+                    return false;
+                }
+                path[path_len] = '\0';
+            }
+        }
+    }
+
+    if (data->type == JSON_ARRAY && schema->items) {
+        JsonArray* arr = data->data.array_value;
+        for (size_t i = 0; i < arr->count; i++) {
+            size_t added = (size_t)snprintf(path + path_len, path_cap - path_len,
+                                            "[%zu]", i);
+            if (added >= path_cap - path_len) added = path_cap - path_len - 1;
+            if (!schema_validate_node(schema->items, arr->values[i],
+                                      path, path_len + added, path_cap)) {
+                return false;
+            }
+            path[path_len] = '\0';
+        }
+    }
+
+    return true;
+}
+
+bool json_schema_validate(const JsonSchema* schema, const JsonValue* data, JsonError* error) {
+    if (!schema || !data) {
+        json_set_error(JSON_ERROR_NULL_POINTER, "Schema or data is NULL", 0, 0);
+        if (error) *error = *json_get_last_error();
+        return false;
+    }
+
+    char path[512] = "$";
+    bool ok = schema_validate_node(schema, data, path, 1, sizeof(path));
+    if (!ok && error) {
+        *error = *json_get_last_error();
+    }
+    return ok;
 }
 
 // Simplified Schema Validation
@@ -278,7 +703,7 @@ bool json_validate_schema(const JsonValue* data, const JsonValue* schema) {
     if (schema->type == JSON_OBJECT) {
         JsonValue* type_val = json_object_get(schema, "type");
         if (type_val && type_val->type == JSON_STRING) {
-            const char* expected_type = type_val->data.string_value;
+            const char* expected_type = json_string_value(type_val);
             
             if (strcmp(expected_type, "object") == 0 && data->type != JSON_OBJECT) return false;
             if (strcmp(expected_type, "array") == 0 && data->type != JSON_ARRAY) return false;
@@ -310,8 +735,10 @@ bool json_validate_schema(const JsonValue* data, const JsonValue* schema) {
 // JSON Diff
 JsonValue* json_diff(const JsonValue* val1, const JsonValue* val2) {
     JsonValue* diff = json_create_object();
-    
-    if (!json_equals(val1, val2)) {
+
+    // Structural hashes replace the full json_equals walk: unequal hashes
+    // prove a difference, equal hashes are trusted (64-bit collision odds)
+    if (json_hash(val1) != json_hash(val2)) {
         json_object_set(diff, "changed", json_create_bool(true));
         json_object_set(diff, "old", json_deep_copy(val1));
         json_object_set(diff, "new", json_deep_copy(val2));
@@ -322,6 +749,74 @@ JsonValue* json_diff(const JsonValue* val1, const JsonValue* val2) {
     return diff;
 }
 
+// One changed/old/new record, json_patch-compatible; a side missing from
+// its object is recorded as null
+static JsonValue* diff_leaf(const JsonValue* a, const JsonValue* b) {
+    JsonValue* leaf = json_create_object();
+    if (!leaf) return NULL;
+    json_object_set(leaf, "changed", json_create_bool(true));
+    json_object_set(leaf, "old", a ? json_deep_copy(a) : json_create_null());
+    json_object_set(leaf, "new", b ? json_deep_copy(b) : json_create_null());
+    return leaf;
+}
+
+// Returns NULL when the subtrees match (decided by memoized hashes, so
+// unchanged subtrees are skipped without descending or copying)
+static JsonValue* diff_node(const JsonValue* a, const JsonValue* b,
+                            JsonHashCache* cache_a, JsonHashCache* cache_b) {
+    if (a && b && json_hash_cached(a, cache_a) == json_hash_cached(b, cache_b)) {
+        return NULL;
+    }
+
+    if (a && b && a->type == JSON_OBJECT && b->type == JSON_OBJECT) {
+        JsonValue* diff = json_create_object();
+        if (!diff) return NULL;
+
+        JsonObject* obj_a = a->data.object_value;
+        for (size_t i = 0; i < obj_a->count; i++) {
+            const char* key = obj_a->pairs[i].key;
+            JsonValue* in_b = json_object_get(b, key);
+            JsonValue* sub = in_b ? diff_node(obj_a->pairs[i].value, in_b, cache_a, cache_b)
+                                  : diff_leaf(obj_a->pairs[i].value, NULL);
+            if (sub && !json_object_set(diff, key, sub)) {
+                json_free(sub);
+            }
+        }
+
+        JsonObject* obj_b = b->data.object_value;
+        for (size_t i = 0; i < obj_b->count; i++) {
+            if (json_object_has(a, obj_b->pairs[i].key)) continue;
+            JsonValue* sub = diff_leaf(NULL, obj_b->pairs[i].value);
+            if (sub && !json_object_set(diff, obj_b->pairs[i].key, sub)) {
+                json_free(sub);
+            }
+        }
+
+        return diff;
+    }
+
+    // Type mismatches, scalars and arrays are reported whole
+    return diff_leaf(a, b);
+}
+
+// Deep diff: objects are compared member by member, producing a nested
+// object with a changed/old/new record at each differing path. Unchanged
+// subtrees are ruled out by structural hash (one O(n) pass per tree,
+// memoized), so the copying work scales with what changed rather than
+// with tree size. An empty result object means the values match.
+JsonValue* json_diff_deep(const JsonValue* val1, const JsonValue* val2) {
+    // A failed cache allocation just degrades to uncached hashing
+    JsonHashCache* cache_a = json_hash_cache_create();
+    JsonHashCache* cache_b = json_hash_cache_create();
+
+    JsonValue* diff = diff_node(val1, val2, cache_a, cache_b);
+
+    json_hash_cache_free(cache_a);
+    json_hash_cache_free(cache_b);
+
+    return diff ? diff : json_create_object();
+}
+
 // JSON Patch (simplified)
 JsonValue* json_patch(JsonValue* target, const JsonValue* patch) {
     if (!target || !patch || patch->type != JSON_OBJECT) return target;
@@ -331,7 +826,23 @@ JsonValue* json_patch(JsonValue* target, const JsonValue* patch) {
         json_free(target);
         return json_deep_copy(new_val);
     }
-    
+
+    return target;
+}
+
+// Moving variant: steals the replacement out of the patch instead of
+// deep-copying it. The patch loses its "new" member.
+JsonValue* json_patch_inplace(JsonValue* target, JsonValue* patch) {
+    if (!target || !patch || patch->type != JSON_OBJECT) return target;
+
+    if (json_object_has(patch, "new")) {
+        JsonValue* new_val = json_object_take(patch, "new");
+        if (new_val) {
+            json_free(target);
+            return new_val;
+        }
+    }
+
     return target;
 }
 
@@ -343,7 +854,10 @@ size_t json_memory_usage(const JsonValue* value) {
     
     switch (value->type) {
         case JSON_STRING:
-            total += strlen(value->data.string_value) + 1;
+            // Inline strings occupy the value itself; nothing extra
+            if (!(value->flags & JSON_VALUE_FLAG_INLINE_STRING)) {
+                total += strlen(value->data.string_value) + 1;
+            }
             break;
         case JSON_ARRAY: {
             JsonArray* arr = value->data.array_value;
@@ -358,6 +872,7 @@ size_t json_memory_usage(const JsonValue* value) {
             JsonObject* obj = value->data.object_value;
             total += sizeof(JsonObject);
             total += obj->capacity * sizeof(JsonPair);
+            total += obj->index_capacity * sizeof(size_t);
             for (size_t i = 0; i < obj->count; i++) {
                 total += strlen(obj->pairs[i].key) + 1;
                 total += json_memory_usage(obj->pairs[i].value);
@@ -371,26 +886,35 @@ size_t json_memory_usage(const JsonValue* value) {
     return total;
 }
 
-void json_optimize_memory(JsonValue* value) {
+void json_optimize_memory_ex(JsonValue* value, bool sort_keys) {
     if (!value) return;
     
     if (value->type == JSON_ARRAY) {
         JsonArray* arr = value->data.array_value;
-        if (arr->capacity > arr->count) {
+        if (arr->capacity > arr->count && !arr->arena) {
             arr->capacity = arr->count;
             arr->values = realloc(arr->values, arr->capacity * sizeof(JsonValue*));
         }
         for (size_t i = 0; i < arr->count; i++) {
-            json_optimize_memory(arr->values[i]);
+            json_optimize_memory_ex(arr->values[i], sort_keys);
         }
     } else if (value->type == JSON_OBJECT) {
         JsonObject* obj = value->data.object_value;
-        if (obj->capacity > obj->count) {
+        if (obj->capacity > obj->count && !obj->arena) {
             obj->capacity = obj->count;
             obj->pairs = realloc(obj->pairs, obj->capacity * sizeof(JsonPair));
         }
         for (size_t i = 0; i < obj->count; i++) {
-            json_optimize_memory(obj->pairs[i].value);
+            json_optimize_memory_ex(obj->pairs[i].value, sort_keys);
+        }
+        // For long-lived trees queried in place, sorted keys give binary
+        // search lookups without a hash index allocation
+        if (sort_keys) {
+            json_object_sort_keys(value);
         }
     }
 }
+
+void json_optimize_memory(JsonValue* value) {
+    json_optimize_memory_ex(value, false);
+}
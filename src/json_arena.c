@@ -0,0 +1,280 @@
+#include "json_parser.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define ARENA_DEFAULT_BLOCK_SIZE (64 * 1024)
+#define ARENA_ALIGNMENT 8
+
+typedef struct ArenaBlock {
+    struct ArenaBlock* next;
+    size_t used;
+    size_t size;
+} ArenaBlock;
+
+struct JsonArena {
+    ArenaBlock* blocks;
+    size_t block_size;
+    size_t total_allocated;
+    // Optional key-intern pool: open-addressing set of arena-owned strings
+    char** intern_slots;
+    size_t intern_capacity;
+    size_t intern_count;
+    bool intern_enabled;
+};
+
+static _Thread_local JsonArena* g_active_arena = NULL;
+
+static inline char* block_data(ArenaBlock* block) {
+    return (char*)(block + 1);
+}
+
+static ArenaBlock* arena_new_block(size_t size) {
+    ArenaBlock* block = malloc(sizeof(ArenaBlock) + size);
+    if (!block) return NULL;
+    block->next = NULL;
+    block->used = 0;
+    block->size = size;
+    return block;
+}
+
+JsonArena* json_arena_create(size_t block_size) {
+    if (block_size == 0) {
+        block_size = ARENA_DEFAULT_BLOCK_SIZE;
+    }
+
+    JsonArena* arena = malloc(sizeof(JsonArena));
+    if (!arena) {
+        json_set_error(JSON_ERROR_OUT_OF_MEMORY, "Failed to allocate arena", 0, 0);
+        return NULL;
+    }
+
+    arena->block_size = block_size;
+    arena->total_allocated = 0;
+    arena->intern_slots = NULL;
+    arena->intern_capacity = 0;
+    arena->intern_count = 0;
+    arena->intern_enabled = false;
+    arena->blocks = arena_new_block(block_size);
+    if (!arena->blocks) {
+        free(arena);
+        json_set_error(JSON_ERROR_OUT_OF_MEMORY, "Failed to allocate arena block", 0, 0);
+        return NULL;
+    }
+
+    return arena;
+}
+
+void json_arena_destroy(JsonArena* arena) {
+    if (!arena) return;
+
+    ArenaBlock* block = arena->blocks;
+    while (block) {
+        ArenaBlock* next = block->next;
+        free(block);
+        block = next;
+    }
+    free(arena->intern_slots);
+    free(arena);
+}
+
+void json_arena_reset(JsonArena* arena) {
+    if (!arena) return;
+
+    // Keep one bump block for reuse, release the rest
+    ArenaBlock* block = arena->blocks->next;
+    while (block) {
+        ArenaBlock* next = block->next;
+        free(block);
+        block = next;
+    }
+    arena->blocks->next = NULL;
+    arena->blocks->used = 0;
+    arena->total_allocated = 0;
+
+    // Interned strings lived in the freed blocks, so the pool must restart
+    if (arena->intern_slots) {
+        memset(arena->intern_slots, 0, arena->intern_capacity * sizeof(char*));
+        arena->intern_count = 0;
+    }
+}
+
+void* json_arena_alloc(JsonArena* arena, size_t size) {
+    if (!arena || size == 0) return NULL;
+
+    size = (size + ARENA_ALIGNMENT - 1) & ~(size_t)(ARENA_ALIGNMENT - 1);
+
+    ArenaBlock* block = arena->blocks;
+
+    if (size > block->size - block->used) {
+        if (size > arena->block_size) {
+            // Oversized request gets its own block, chained behind the
+            // current one so the bump block stays usable
+            ArenaBlock* big = arena_new_block(size);
+            if (!big) {
+                json_set_error(JSON_ERROR_OUT_OF_MEMORY, "Failed to allocate arena block", 0, 0);
+                return NULL;
+            }
+            big->used = size;
+            big->next = block->next;
+            block->next = big;
+            arena->total_allocated += size;
+            return block_data(big);
+        }
+
+        ArenaBlock* fresh = arena_new_block(arena->block_size);
+        if (!fresh) {
+            json_set_error(JSON_ERROR_OUT_OF_MEMORY, "Failed to allocate arena block", 0, 0);
+            return NULL;
+        }
+        fresh->next = block;
+        arena->blocks = fresh;
+        block = fresh;
+    }
+
+    void* ptr = block_data(block) + block->used;
+    block->used += size;
+    arena->total_allocated += size;
+    return ptr;
+}
+
+void* json_arena_grow(JsonArena* arena, void* ptr, size_t old_size, size_t new_size) {
+    if (!arena) {
+        return realloc(ptr, new_size);
+    }
+
+    void* fresh = json_arena_alloc(arena, new_size);
+    if (!fresh) return NULL;
+
+    if (ptr && old_size > 0) {
+        memcpy(fresh, ptr, old_size < new_size ? old_size : new_size);
+    }
+    return fresh;
+}
+
+char* json_arena_strdup(JsonArena* arena, const char* str) {
+    if (!str) return NULL;
+
+    size_t len = strlen(str) + 1;
+    char* copy = arena ? json_arena_alloc(arena, len) : malloc(len);
+    if (!copy) return NULL;
+
+    memcpy(copy, str, len);
+    return copy;
+}
+
+size_t json_arena_memory_usage(const JsonArena* arena) {
+    if (!arena) return 0;
+
+    size_t total = sizeof(JsonArena);
+    for (const ArenaBlock* block = arena->blocks; block; block = block->next) {
+        total += sizeof(ArenaBlock) + block->size;
+    }
+    return total;
+}
+
+#define INTERN_INITIAL_CAPACITY 64
+
+static size_t intern_hash(const char* str) {
+    // FNV-1a
+    size_t hash = 14695981039346656037ULL;
+    while (*str) {
+        hash ^= (unsigned char)*str++;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+static bool intern_grow(JsonArena* arena) {
+    size_t new_capacity = arena->intern_capacity == 0
+                              ? INTERN_INITIAL_CAPACITY
+                              : arena->intern_capacity * 2;
+    char** new_slots = calloc(new_capacity, sizeof(char*));
+    if (!new_slots) return false;
+
+    for (size_t i = 0; i < arena->intern_capacity; i++) {
+        char* entry = arena->intern_slots[i];
+        if (!entry) continue;
+        size_t slot = intern_hash(entry) & (new_capacity - 1);
+        while (new_slots[slot]) {
+            slot = (slot + 1) & (new_capacity - 1);
+        }
+        new_slots[slot] = entry;
+    }
+
+    free(arena->intern_slots);
+    arena->intern_slots = new_slots;
+    arena->intern_capacity = new_capacity;
+    return true;
+}
+
+// Opt in to key deduplication: subsequent json_arena_intern calls return a
+// shared arena-owned copy per distinct string. The pool survives until the
+// arena is reset or destroyed.
+void json_arena_enable_interning(JsonArena* arena) {
+    if (!arena) return;
+    arena->intern_enabled = true;
+}
+
+const char* json_arena_intern(JsonArena* arena, const char* str) {
+    if (!str) return NULL;
+
+    if (!arena || !arena->intern_enabled) {
+        return json_arena_strdup(arena, str);
+    }
+
+    // Keep load factor below 1/2 so linear probing stays short
+    if (arena->intern_count * 2 >= arena->intern_capacity) {
+        if (!intern_grow(arena)) {
+            json_set_error(JSON_ERROR_OUT_OF_MEMORY, "Failed to grow intern pool", 0, 0);
+            return NULL;
+        }
+    }
+
+    size_t slot = intern_hash(str) & (arena->intern_capacity - 1);
+    while (arena->intern_slots[slot]) {
+        if (strcmp(arena->intern_slots[slot], str) == 0) {
+            return arena->intern_slots[slot];
+        }
+        slot = (slot + 1) & (arena->intern_capacity - 1);
+    }
+
+    char* copy = json_arena_strdup(arena, str);
+    if (!copy) {
+        json_set_error(JSON_ERROR_OUT_OF_MEMORY, "Failed to intern string", 0, 0);
+        return NULL;
+    }
+    arena->intern_slots[slot] = copy;
+    arena->intern_count++;
+    return copy;
+}
+
+JsonArena* json_arena_active(void) {
+    return g_active_arena;
+}
+
+// Route subsequent json_create_* calls on this thread into the arena;
+// returns the previously active arena so callers can restore it.
+JsonArena* json_arena_activate(JsonArena* arena) {
+    JsonArena* previous = g_active_arena;
+    g_active_arena = arena;
+    return previous;
+}
+
+JsonValue* json_parse_arena_with_error(const char* json_string, JsonArena* arena, JsonError* error) {
+    if (!arena) {
+        json_set_error(JSON_ERROR_NULL_POINTER, "Arena is NULL", 0, 0);
+        if (error) *error = g_json_last_error;
+        return NULL;
+    }
+
+    JsonArena* previous = g_active_arena;
+    g_active_arena = arena;
+    JsonValue* result = json_parse_with_error(json_string, error);
+    g_active_arena = previous;
+
+    return result;
+}
+
+JsonValue* json_parse_arena(const char* json_string, JsonArena* arena) {
+    return json_parse_arena_with_error(json_string, arena, NULL);
+}
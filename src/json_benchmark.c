@@ -1,154 +1,479 @@
+#define _POSIX_C_SOURCE 200809L
+
 #include "json_parser.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdint.h>
+#include <math.h>
 #include <time.h>
+#include <dirent.h>
 
 #ifndef CLOCK_MONOTONIC
 #define CLOCK_MONOTONIC 1
 #endif
 
-typedef struct {
-    double parse_time;
-    double stringify_time;
-    size_t memory_used;
-    size_t input_size;
-} BenchmarkResult;
+// Benchmark harness: every case runs a warmup, then repeated timed
+// iterations at nanosecond resolution until a time budget is spent.
+// Reported numbers are median/p99/stddev over the samples plus MB/s and
+// docs/s throughput, so runs can be compared across builds. Set
+// CJSON_BENCH_CSV=<path> for machine-readable output and
+// CJSON_BENCH_CORPUS=<dir> to additionally measure every *.json file
+// in that directory (e.g. twitter.json / canada.json corpora).
 
-static double get_time_ms(void) {
+#define BENCH_WARMUP_ITERATIONS 3
+#define BENCH_MIN_SAMPLES 10
+#define BENCH_MAX_SAMPLES 1000
+#define BENCH_TIME_BUDGET_NS 200000000ULL  /* 200ms per case */
+
+static uint64_t now_ns(void) {
     struct timespec ts;
     clock_gettime(CLOCK_MONOTONIC, &ts);
-    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
-}
-
-BenchmarkResult benchmark_simple_object(void) {
-    BenchmarkResult result = {0};
-    
-    const char* json = "{\"name\":\"Test\",\"value\":123,\"active\":true,\"data\":null}";
-    result.input_size = strlen(json);
-    
-    double start = get_time_ms();
-    JsonValue* value = json_parse(json);
-    double end = get_time_ms();
-    result.parse_time = end - start;
-    
-    if (value) {
-        result.memory_used = json_memory_usage(value);
-        
-        start = get_time_ms();
-        char* output = json_stringify(value, false);
-        end = get_time_ms();
-        result.stringify_time = end - start;
-        
-        free(output);
-        json_free(value);
-    }
-    
-    return result;
-}
-
-BenchmarkResult benchmark_large_array(int size) {
-    BenchmarkResult result = {0};
-    
-    char* json = malloc(size * 100);
-    strcpy(json, "[");
-    
-    for (int i = 0; i < size; i++) {
-        if (i > 0) strcat(json, ",");
-        char buf[100];
-        sprintf(buf, "{\"id\":%d,\"name\":\"Item%d\",\"value\":%d}", i, i, i * 10);
-        strcat(json, buf);
-    }
-    strcat(json, "]");
-    
-    result.input_size = strlen(json);
-    
-    double start = get_time_ms();
-    JsonValue* value = json_parse(json);
-    double end = get_time_ms();
-    result.parse_time = end - start;
-    
-    if (value) {
-        result.memory_used = json_memory_usage(value);
-        
-        start = get_time_ms();
-        char* output = json_stringify(value, false);
-        end = get_time_ms();
-        result.stringify_time = end - start;
-        
-        free(output);
-        json_free(value);
-    }
-    
-    free(json);
-    return result;
-}
-
-BenchmarkResult benchmark_deep_nesting(int depth) {
-    BenchmarkResult result = {0};
-    
-    char* json = malloc(depth * 20);
-    json[0] = '\0';
-    
-    for (int i = 0; i < depth; i++) {
-        strcat(json, "{\"nested\":");
-    }
-    strcat(json, "\"value\"");
-    for (int i = 0; i < depth; i++) {
-        strcat(json, "}");
-    }
-    
-    result.input_size = strlen(json);
-    
-    double start = get_time_ms();
-    JsonValue* value = json_parse(json);
-    double end = get_time_ms();
-    result.parse_time = end - start;
-    
-    if (value) {
-        result.memory_used = json_memory_usage(value);
-        
-        start = get_time_ms();
-        char* output = json_stringify(value, false);
-        end = get_time_ms();
-        result.stringify_time = end - start;
-        
-        free(output);
-        json_free(value);
-    }
-    
-    free(json);
-    return result;
-}
-
-void print_benchmark_result(const char* name, BenchmarkResult result) {
-    printf("%-30s | Parse: %8.3f ms | Stringify: %8.3f ms | Memory: %8zu bytes | Input: %8zu bytes\n",
-           name, result.parse_time, result.stringify_time, result.memory_used, result.input_size);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+typedef struct {
+    const char* name;
+    size_t iterations;
+    double mean_ns;
+    double median_ns;
+    double p99_ns;
+    double stddev_ns;
+    double mb_per_s;
+    double docs_per_s;
+} BenchResult;
+
+typedef void (*BenchFn)(void* ctx);
+
+static FILE* g_csv = NULL;
+static volatile double g_sink;
+
+static int compare_u64(const void* a, const void* b) {
+    uint64_t x = *(const uint64_t*)a;
+    uint64_t y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+static void bench_report(const BenchResult* r) {
+    printf("%-28s | %6zu it | med %10.0f ns | p99 %10.0f ns | sd %9.0f | %8.1f MB/s | %10.0f docs/s\n",
+           r->name, r->iterations, r->median_ns, r->p99_ns, r->stddev_ns,
+           r->mb_per_s, r->docs_per_s);
+    if (g_csv) {
+        fprintf(g_csv, "%s,%zu,%.1f,%.1f,%.1f,%.1f,%.3f,%.1f\n",
+                r->name, r->iterations, r->mean_ns, r->median_ns, r->p99_ns,
+                r->stddev_ns, r->mb_per_s, r->docs_per_s);
+    }
+}
+
+// bytes/docs describe one iteration's payload and feed the throughput
+// numbers; pass 0 to omit them.
+static void bench_run(const char* name, BenchFn fn, void* ctx, size_t bytes, size_t docs) {
+    static uint64_t samples[BENCH_MAX_SAMPLES];
+
+    for (int i = 0; i < BENCH_WARMUP_ITERATIONS; i++) {
+        fn(ctx);
+    }
+
+    size_t count = 0;
+    uint64_t spent = 0;
+    while (count < BENCH_MAX_SAMPLES &&
+           (count < BENCH_MIN_SAMPLES || spent < BENCH_TIME_BUDGET_NS)) {
+        uint64_t start = now_ns();
+        fn(ctx);
+        uint64_t elapsed = now_ns() - start;
+        samples[count++] = elapsed;
+        spent += elapsed;
+    }
+
+    qsort(samples, count, sizeof(uint64_t), compare_u64);
+
+    double mean = 0;
+    for (size_t i = 0; i < count; i++) mean += (double)samples[i];
+    mean /= (double)count;
+
+    double variance = 0;
+    for (size_t i = 0; i < count; i++) {
+        double d = (double)samples[i] - mean;
+        variance += d * d;
+    }
+    variance /= (double)count;
+
+    BenchResult r = {
+        .name = name,
+        .iterations = count,
+        .mean_ns = mean,
+        .median_ns = (double)samples[count / 2],
+        .p99_ns = (double)samples[(count * 99) / 100 < count ? (count * 99) / 100 : count - 1],
+        .stddev_ns = sqrt(variance),
+        .mb_per_s = 0,
+        .docs_per_s = 0,
+    };
+    double median_s = r.median_ns / 1e9;
+    if (bytes && median_s > 0) r.mb_per_s = ((double)bytes / (1024.0 * 1024.0)) / median_s;
+    if (docs && median_s > 0) r.docs_per_s = (double)docs / median_s;
+    bench_report(&r);
+}
+
+// Growable builder for corpus synthesis (replaces the old O(n^2) strcat)
+typedef struct {
+    char* data;
+    size_t length;
+    size_t capacity;
+} CorpusBuilder;
+
+static void corpus_append(CorpusBuilder* b, const char* str) {
+    size_t len = strlen(str);
+    if (b->length + len + 1 > b->capacity) {
+        size_t new_capacity = b->capacity ? b->capacity : 4096;
+        while (b->length + len + 1 > new_capacity) new_capacity *= 2;
+        char* fresh = realloc(b->data, new_capacity);
+        if (!fresh) return;
+        b->data = fresh;
+        b->capacity = new_capacity;
+    }
+    memcpy(b->data + b->length, str, len + 1);
+    b->length += len;
+}
+
+// Array of small records: object-dense with short keys and strings,
+// the twitter.json-style shape
+static char* build_record_array(int count, size_t* out_len) {
+    CorpusBuilder b = {0};
+    corpus_append(&b, "{\"items\":[");
+    char buf[256];
+    for (int i = 0; i < count; i++) {
+        snprintf(buf, sizeof(buf),
+                 "%s{\"id\":%d,\"name\":\"Item%d\",\"value\":%d,\"score\":%d.%02d,\"active\":%s}",
+                 i ? "," : "", i, i, i * 10, i % 97, i % 100,
+                 (i & 1) ? "true" : "false");
+        corpus_append(&b, buf);
+    }
+    corpus_append(&b, "]}");
+    if (out_len) *out_len = b.length;
+    return b.data;
+}
+
+// Flat records only (no nesting), suitable for the CSV/SQLite paths.
+// "id" is avoided as a key: the SQLite bridge adds its own id column.
+static char* build_flat_records(int count, size_t* out_len) {
+    CorpusBuilder b = {0};
+    corpus_append(&b, "[");
+    char buf[160];
+    for (int i = 0; i < count; i++) {
+        snprintf(buf, sizeof(buf),
+                 "%s{\"seq\":%d,\"name\":\"row%d\",\"value\":%d.%d}",
+                 i ? "," : "", i, i, i, i % 10);
+        corpus_append(&b, buf);
+    }
+    corpus_append(&b, "]");
+    if (out_len) *out_len = b.length;
+    return b.data;
+}
+
+// Nested arrays of doubles, the canada.json-style number-heavy shape
+static char* build_numeric_matrix(int rows, int cols, size_t* out_len) {
+    CorpusBuilder b = {0};
+    corpus_append(&b, "[");
+    char buf[64];
+    for (int r = 0; r < rows; r++) {
+        corpus_append(&b, r ? ",[" : "[");
+        for (int c = 0; c < cols; c++) {
+            snprintf(buf, sizeof(buf), "%s%d.%06d", c ? "," : "",
+                     (r * cols + c) % 180 - 90, (r * 7919 + c * 104729) % 1000000);
+            corpus_append(&b, buf);
+        }
+        corpus_append(&b, "]");
+    }
+    corpus_append(&b, "]");
+    if (out_len) *out_len = b.length;
+    return b.data;
+}
+
+// depth pairs of "[{" ... "}]" nesting with a scalar at the bottom —
+// exercises the iterative parser/free/copy/equals paths well past the
+// default depth limit
+static char* build_deep_nesting(size_t depth, size_t* out_len) {
+    size_t len = depth * 9 + 1;
+    char* buffer = malloc(len + 1);
+    if (!buffer) return NULL;
+
+    char* p = buffer;
+    for (size_t i = 0; i < depth; i++) {
+        memcpy(p, "[{\"a\":", 6);
+        p += 6;
+    }
+    *p++ = '0';
+    for (size_t i = 0; i < depth; i++) {
+        memcpy(p, "}]", 2);
+        p += 2;
+    }
+    *p = '\0';
+    *out_len = (size_t)(p - buffer);
+    return buffer;
+}
+
+typedef struct {
+    const char* buffer;
+    size_t length;
+    JsonValue* tree;
+    char* aux;
+} BenchCtx;
+
+static void bench_parse(void* arg) {
+    BenchCtx* ctx = arg;
+    JsonValue* v = json_parse_buffer(ctx->buffer, ctx->length);
+    json_free(v);
+}
+
+static void bench_validate(void* arg) {
+    BenchCtx* ctx = arg;
+    json_validate(ctx->buffer);
+}
+
+static void bench_stringify(void* arg) {
+    BenchCtx* ctx = arg;
+    char* out = json_stringify(ctx->tree, false);
+    free(out);
+}
+
+static void bench_stringify_pretty(void* arg) {
+    BenchCtx* ctx = arg;
+    char* out = json_stringify(ctx->tree, true);
+    free(out);
+}
+
+static void bench_path_query(void* arg) {
+    BenchCtx* ctx = arg;
+    JsonValue* result = json_path_query(ctx->tree, "$.items[0:100]");
+    json_free(result);
+}
+
+static void bench_to_csv(void* arg) {
+    BenchCtx* ctx = arg;
+    char* out = json_to_csv(ctx->tree);
+    free(out);
+}
+
+static void bench_csv_parse(void* arg) {
+    BenchCtx* ctx = arg;
+    JsonValue* v = csv_to_json(ctx->aux);
+    json_free(v);
+}
+
+static bool bench_stream_sink(JsonStreamEvent* event, void* user_data) {
+    size_t* counter = user_data;
+    (void)event;
+    (*counter)++;
+    return true;
+}
+
+static void bench_streaming(void* arg) {
+    BenchCtx* ctx = arg;
+    size_t events = 0;
+    JsonStreamParser* parser = json_stream_parser_create(bench_stream_sink, &events);
+    if (!parser) return;
+    const size_t chunk = 64 * 1024;
+    for (size_t off = 0; off < ctx->length; off += chunk) {
+        size_t take = ctx->length - off < chunk ? ctx->length - off : chunk;
+        if (!json_stream_parse_chunk(parser, ctx->buffer + off, take)) break;
+    }
+    json_stream_parser_free(parser);
+}
+
+static void bench_deep_copy_equals(void* arg) {
+    BenchCtx* ctx = arg;
+    JsonValue* copy = json_deep_copy(ctx->tree);
+    if (copy) {
+        json_equals(ctx->tree, copy);
+        json_free(copy);
+    }
+}
+
+// Tree vs columnar aggregation over the same records: the tree walk
+// chases a pointer per field, the columnar scan reads a double array
+static void bench_tree_sum(void* arg) {
+    BenchCtx* ctx = arg;
+    JsonArray* arr = ctx->tree->data.array_value;
+    double sum = 0.0;
+    for (size_t i = 0; i < arr->count; i++) {
+        JsonValue* v = json_object_get(arr->values[i], "value");
+        if (v && v->type == JSON_NUMBER) sum += v->data.number_value;
+    }
+    g_sink = sum;
+}
+
+static JsonColumnSet* g_bench_columns;
+
+static void bench_columnar_sum(void* arg) {
+    (void)arg;
+    const double* values = json_columnar_numbers(g_bench_columns, "value");
+    size_t rows = json_columnar_row_count(g_bench_columns);
+    double sum = 0.0;
+    for (size_t i = 0; i < rows; i++) sum += values[i];
+    g_sink = sum;
+}
+
+static void bench_sqlite(void* arg) {
+    BenchCtx* ctx = arg;
+    JsonSqliteDB* db = json_to_sqlite(ctx->tree, ":memory:");
+    if (db) sqlite_close(db);
+}
+
+static char* read_corpus_file(const char* path, size_t* out_len) {
+    FILE* file = fopen(path, "rb");
+    if (!file) return NULL;
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    if (size <= 0) {
+        fclose(file);
+        return NULL;
+    }
+    char* data = malloc((size_t)size + 1);
+    if (!data || fread(data, 1, (size_t)size, file) != (size_t)size) {
+        free(data);
+        fclose(file);
+        return NULL;
+    }
+    fclose(file);
+    data[size] = '\0';
+    if (out_len) *out_len = (size_t)size;
+    return data;
+}
+
+static void run_corpus_dir(const char* dir) {
+    DIR* d = opendir(dir);
+    if (!d) {
+        printf("corpus dir '%s' not readable, skipping\n", dir);
+        return;
+    }
+
+    struct dirent* entry;
+    while ((entry = readdir(d)) != NULL) {
+        const char* dot = strrchr(entry->d_name, '.');
+        if (!dot || strcmp(dot, ".json") != 0) continue;
+
+        char path[1024];
+        snprintf(path, sizeof(path), "%s/%s", dir, entry->d_name);
+
+        size_t length = 0;
+        char* data = read_corpus_file(path, &length);
+        if (!data) continue;
+
+        BenchCtx ctx = {data, length, NULL, NULL};
+        char label[160];
+        snprintf(label, sizeof(label), "parse %.100s", entry->d_name);
+        bench_run(label, bench_parse, &ctx, length, 1);
+
+        ctx.tree = json_parse_buffer(data, length);
+        if (ctx.tree) {
+            snprintf(label, sizeof(label), "stringify %.100s", entry->d_name);
+            bench_run(label, bench_stringify, &ctx, length, 1);
+            json_free(ctx.tree);
+        }
+        free(data);
+    }
+    closedir(d);
 }
 
 void run_all_benchmarks(void) {
+    const char* csv_path = getenv("CJSON_BENCH_CSV");
+    if (csv_path) {
+        g_csv = fopen(csv_path, "w");
+        if (g_csv) {
+            fprintf(g_csv, "name,iterations,mean_ns,median_ns,p99_ns,stddev_ns,mb_per_s,docs_per_s\n");
+        }
+    }
+
     printf("\n=== JSON Parser Benchmarks ===\n\n");
-    printf("%-30s | %-17s | %-21s | %-20s | %s\n", 
-           "Test Name", "Parse Time", "Stringify Time", "Memory Usage", "Input Size");
-    printf("---------------------------------------------------------------------------------------------------------------------------\n");
-    
-    BenchmarkResult r1 = benchmark_simple_object();
-    print_benchmark_result("Simple Object", r1);
-    
-    BenchmarkResult r2 = benchmark_large_array(100);
-    print_benchmark_result("Array (100 items)", r2);
-    
-    BenchmarkResult r3 = benchmark_large_array(1000);
-    print_benchmark_result("Array (1000 items)", r3);
-    
-    BenchmarkResult r4 = benchmark_large_array(10000);
-    print_benchmark_result("Array (10000 items)", r4);
-    
-    BenchmarkResult r5 = benchmark_deep_nesting(50);
-    print_benchmark_result("Deep Nesting (50 levels)", r5);
-    
-    BenchmarkResult r6 = benchmark_deep_nesting(100);
-    print_benchmark_result("Deep Nesting (100 levels)", r6);
-    
+
+    size_t records_len = 0, flat_len = 0, matrix_len = 0;
+    char* records = build_record_array(5000, &records_len);
+    char* flat = build_flat_records(2000, &flat_len);
+    char* matrix = build_numeric_matrix(100, 250, &matrix_len);
+    if (!records || !flat || !matrix) {
+        free(records);
+        free(flat);
+        free(matrix);
+        printf("corpus allocation failed\n");
+        return;
+    }
+
+    JsonValue* records_tree = json_parse_buffer(records, records_len);
+    JsonValue* flat_tree = json_parse_buffer(flat, flat_len);
+    char* flat_csv = flat_tree ? json_to_csv(flat_tree) : NULL;
+
+    BenchCtx records_ctx = {records, records_len, records_tree, NULL};
+    BenchCtx flat_ctx = {flat, flat_len, flat_tree, flat_csv};
+    BenchCtx matrix_ctx = {matrix, matrix_len, NULL, NULL};
+
+    bench_run("parse records (5k)", bench_parse, &records_ctx, records_len, 5000);
+    bench_run("parse numbers (25k)", bench_parse, &matrix_ctx, matrix_len, 1);
+    bench_run("validate records", bench_validate, &records_ctx, records_len, 5000);
+    bench_run("streaming records", bench_streaming, &records_ctx, records_len, 5000);
+
+    if (records_tree) {
+        bench_run("stringify records", bench_stringify, &records_ctx, records_len, 5000);
+        bench_run("stringify pretty", bench_stringify_pretty, &records_ctx, records_len, 5000);
+        bench_run("path $.items[0:100]", bench_path_query, &records_ctx, 0, 100);
+    }
+
+    if (flat_tree) {
+        bench_run("json_to_csv (2k rows)", bench_to_csv, &flat_ctx, flat_len, 2000);
+        bench_run("sqlite insert (2k rows)", bench_sqlite, &flat_ctx, flat_len, 2000);
+
+        g_bench_columns = json_columnar_from_array(flat_tree);
+        if (g_bench_columns) {
+            bench_run("sum field, tree (2k rows)", bench_tree_sum, &flat_ctx, 0, 2000);
+            bench_run("sum field, columnar (2k rows)", bench_columnar_sum, &flat_ctx, 0, 2000);
+            json_columnar_free(g_bench_columns);
+            g_bench_columns = NULL;
+        }
+    }
+    if (flat_csv) {
+        bench_run("csv_to_json (2k rows)", bench_csv_parse, &flat_ctx, strlen(flat_csv), 2000);
+    }
+
+    // Deep-nesting suite: 10k levels, far beyond the default cap, runs as
+    // long as the raised limit holds
+    size_t deep_len = 0;
+    char* deep = build_deep_nesting(10000, &deep_len);
+    if (deep) {
+        size_t saved_depth = json_get_max_depth();
+        json_set_max_depth(25000);
+
+        JsonValue* deep_tree = json_parse_buffer(deep, deep_len);
+        if (deep_tree) {
+            BenchCtx deep_ctx = {deep, deep_len, deep_tree, NULL};
+            bench_run("deep parse (10k levels)", bench_parse, &deep_ctx, deep_len, 1);
+            bench_run("deep validate (10k levels)", bench_validate, &deep_ctx, deep_len, 1);
+            bench_run("deep copy+equals (10k levels)", bench_deep_copy_equals, &deep_ctx, deep_len, 1);
+            json_free(deep_tree);
+        } else {
+            printf("deep corpus parse failed: %s\n", json_get_last_error()->message);
+        }
+
+        json_set_max_depth(saved_depth);
+        free(deep);
+    }
+
+    const char* corpus_dir = getenv("CJSON_BENCH_CORPUS");
+    if (corpus_dir) {
+        printf("\n--- corpus: %s ---\n", corpus_dir);
+        run_corpus_dir(corpus_dir);
+    }
+
     printf("\n");
+
+    free(flat_csv);
+    json_free(records_tree);
+    json_free(flat_tree);
+    free(records);
+    free(flat);
+    free(matrix);
+
+    if (g_csv) {
+        fclose(g_csv);
+        g_csv = NULL;
+    }
 }
@@ -0,0 +1,294 @@
+#include "json_parser.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdint.h>
+
+// Binary snapshot of a JsonValue tree: a flat, pointer-free preorder
+// layout with length-prefixed strings and count-prefixed child tables.
+// Loading is one read of the file followed by a single pass that
+// rebuilds the tree, skipping tokenization, number conversion and
+// escape handling entirely. The format is native-endian and meant for
+// same-machine snapshot/restore, not interchange.
+
+#define JSON_BINARY_MAGIC 0x4253434Au  /* "JCSB" */
+#define JSON_BINARY_VERSION 1u
+
+static bool write_bytes(FILE* file, const void* data, size_t size) {
+    if (fwrite(data, 1, size, file) != size) {
+        json_set_error(JSON_ERROR_FILE_WRITE_ERROR, "Failed to write snapshot", 0, 0);
+        return false;
+    }
+    return true;
+}
+
+static bool write_u64(FILE* file, uint64_t v) {
+    return write_bytes(file, &v, sizeof(v));
+}
+
+// Both traversals honor the same per-thread nesting limit as the parser,
+// so a crafted or overly deep snapshot is an error, not a stack overflow
+static bool write_node(FILE* file, const JsonValue* value, size_t depth) {
+    if (depth >= json_get_max_depth()) {
+        json_set_error(JSON_ERROR_STACK_OVERFLOW, "Snapshot nesting too deep", 0, 0);
+        return false;
+    }
+
+    uint8_t type = (uint8_t)value->type;
+    if (!write_bytes(file, &type, 1)) return false;
+
+    switch (value->type) {
+        case JSON_NULL:
+            return true;
+
+        case JSON_BOOL: {
+            uint8_t b = value->data.bool_value ? 1 : 0;
+            return write_bytes(file, &b, 1);
+        }
+
+        case JSON_NUMBER:
+            return write_bytes(file, &value->data.number_value, sizeof(double));
+
+        case JSON_STRING: {
+            const char* str = json_string_value(value);
+            uint64_t len = strlen(str);
+            return write_u64(file, len) &&
+                   write_bytes(file, str, len);
+        }
+
+        case JSON_ARRAY: {
+            JsonArray* arr = value->data.array_value;
+            if (!write_u64(file, arr->count)) return false;
+            for (size_t i = 0; i < arr->count; i++) {
+                if (!write_node(file, arr->values[i], depth + 1)) return false;
+            }
+            return true;
+        }
+
+        case JSON_OBJECT: {
+            JsonObject* obj = value->data.object_value;
+            if (!write_u64(file, obj->count)) return false;
+            for (size_t i = 0; i < obj->count; i++) {
+                uint64_t key_len = strlen(obj->pairs[i].key);
+                if (!write_u64(file, key_len)) return false;
+                if (!write_bytes(file, obj->pairs[i].key, key_len)) return false;
+                if (!write_node(file, obj->pairs[i].value, depth + 1)) return false;
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+bool json_save_binary(const char* filename, const JsonValue* value) {
+    if (!filename || !value) {
+        json_set_error(JSON_ERROR_NULL_POINTER, "Filename or value is NULL", 0, 0);
+        return false;
+    }
+
+    FILE* file = fopen(filename, "wb");
+    if (!file) {
+        char error_msg[512];
+        snprintf(error_msg, sizeof(error_msg), "Cannot open file for writing: %s", filename);
+        json_set_error(JSON_ERROR_FILE_WRITE_ERROR, error_msg, 0, 0);
+        return false;
+    }
+
+    uint32_t header[2] = {JSON_BINARY_MAGIC, JSON_BINARY_VERSION};
+    bool ok = write_bytes(file, header, sizeof(header)) && write_node(file, value, 0);
+
+    if (fclose(file) != 0 && ok) {
+        json_set_error(JSON_ERROR_FILE_WRITE_ERROR, "Failed to close snapshot file", 0, 0);
+        ok = false;
+    }
+    return ok;
+}
+
+typedef struct {
+    const char* cursor;
+    const char* end;
+} BinaryReader;
+
+static bool reader_take(BinaryReader* r, void* out, size_t size) {
+    if ((size_t)(r->end - r->cursor) < size) {
+        json_set_error(JSON_ERROR_INVALID_SYNTAX, "Truncated binary snapshot", 0, 0);
+        return false;
+    }
+    memcpy(out, r->cursor, size);
+    r->cursor += size;
+    return true;
+}
+
+static char* reader_take_string(BinaryReader* r, uint64_t len) {
+    if ((uint64_t)(r->end - r->cursor) < len) {
+        json_set_error(JSON_ERROR_INVALID_SYNTAX, "Truncated binary snapshot", 0, 0);
+        return NULL;
+    }
+
+    char* str = malloc(len + 1);
+    if (!str) {
+        json_set_error(JSON_ERROR_OUT_OF_MEMORY, "Failed to allocate snapshot string", 0, 0);
+        return NULL;
+    }
+    memcpy(str, r->cursor, len);
+    str[len] = '\0';
+    r->cursor += len;
+    return str;
+}
+
+static JsonValue* read_node(BinaryReader* r, size_t depth) {
+    if (depth >= json_get_max_depth()) {
+        json_set_error(JSON_ERROR_STACK_OVERFLOW, "Snapshot nesting too deep", 0, 0);
+        return NULL;
+    }
+
+    uint8_t type;
+    if (!reader_take(r, &type, 1)) return NULL;
+
+    switch (type) {
+        case JSON_NULL:
+            return json_create_null();
+
+        case JSON_BOOL: {
+            uint8_t b;
+            if (!reader_take(r, &b, 1)) return NULL;
+            return json_create_bool(b != 0);
+        }
+
+        case JSON_NUMBER: {
+            double num;
+            if (!reader_take(r, &num, sizeof(double))) return NULL;
+            return json_create_number(num);
+        }
+
+        case JSON_STRING: {
+            uint64_t len;
+            if (!reader_take(r, &len, sizeof(len))) return NULL;
+            char* str = reader_take_string(r, len);
+            if (!str) return NULL;
+            JsonValue* value = json_create_string(str);
+            free(str);
+            return value;
+        }
+
+        case JSON_ARRAY: {
+            uint64_t count;
+            if (!reader_take(r, &count, sizeof(count))) return NULL;
+            JsonValue* array = json_create_array();
+            if (!array) return NULL;
+
+            for (uint64_t i = 0; i < count; i++) {
+                JsonValue* child = read_node(r, depth + 1);
+                if (!child || !json_array_append(array, child)) {
+                    json_free(child);
+                    json_free(array);
+                    return NULL;
+                }
+            }
+            return array;
+        }
+
+        case JSON_OBJECT: {
+            uint64_t count;
+            if (!reader_take(r, &count, sizeof(count))) return NULL;
+            JsonValue* object = json_create_object();
+            if (!object) return NULL;
+
+            for (uint64_t i = 0; i < count; i++) {
+                uint64_t key_len;
+                if (!reader_take(r, &key_len, sizeof(key_len))) {
+                    json_free(object);
+                    return NULL;
+                }
+                char* key = reader_take_string(r, key_len);
+                if (!key) {
+                    json_free(object);
+                    return NULL;
+                }
+
+                JsonValue* child = read_node(r, depth + 1);
+                if (!child || !json_object_set(object, key, child)) {
+                    json_free(child);
+                    free(key);
+                    json_free(object);
+                    return NULL;
+                }
+                free(key);
+            }
+            return object;
+        }
+    }
+
+    json_set_error(JSON_ERROR_INVALID_SYNTAX, "Unknown node type in binary snapshot", 0, 0);
+    return NULL;
+}
+
+JsonValue* json_load_binary(const char* filename) {
+    if (!filename) {
+        json_set_error(JSON_ERROR_NULL_POINTER, "Filename is NULL", 0, 0);
+        return NULL;
+    }
+
+    FILE* file = fopen(filename, "rb");
+    if (!file) {
+        char error_msg[512];
+        snprintf(error_msg, sizeof(error_msg), "Cannot open file: %s", filename);
+        json_set_error(JSON_ERROR_FILE_NOT_FOUND, error_msg, 0, 0);
+        return NULL;
+    }
+
+    if (fseek(file, 0, SEEK_END) != 0) {
+        json_set_error(JSON_ERROR_FILE_READ_ERROR, "Cannot seek to end of file", 0, 0);
+        fclose(file);
+        return NULL;
+    }
+
+    long size = ftell(file);
+    if (size < (long)(sizeof(uint32_t) * 2)) {
+        json_set_error(JSON_ERROR_FILE_READ_ERROR, "File too small for snapshot header", 0, 0);
+        fclose(file);
+        return NULL;
+    }
+
+    if (fseek(file, 0, SEEK_SET) != 0) {
+        json_set_error(JSON_ERROR_FILE_READ_ERROR, "Cannot seek to start of file", 0, 0);
+        fclose(file);
+        return NULL;
+    }
+
+    char* buffer = malloc(size);
+    if (!buffer) {
+        json_set_error(JSON_ERROR_OUT_OF_MEMORY, "Cannot allocate buffer for snapshot", 0, 0);
+        fclose(file);
+        return NULL;
+    }
+
+    if (fread(buffer, 1, size, file) != (size_t)size) {
+        json_set_error(JSON_ERROR_FILE_READ_ERROR, "Failed to read snapshot file", 0, 0);
+        free(buffer);
+        fclose(file);
+        return NULL;
+    }
+    fclose(file);
+
+    uint32_t magic, version;
+    memcpy(&magic, buffer, sizeof(magic));
+    memcpy(&version, buffer + sizeof(magic), sizeof(version));
+    if (magic != JSON_BINARY_MAGIC || version != JSON_BINARY_VERSION) {
+        json_set_error(JSON_ERROR_INVALID_SYNTAX, "Not a JSON binary snapshot (bad magic or version)", 0, 0);
+        free(buffer);
+        return NULL;
+    }
+
+    BinaryReader reader = {buffer + sizeof(uint32_t) * 2, buffer + size};
+    JsonValue* result = read_node(&reader, 0);
+
+    if (result && reader.cursor != reader.end) {
+        json_set_error(JSON_ERROR_INVALID_SYNTAX, "Trailing data in binary snapshot", 0, 0);
+        json_free(result);
+        result = NULL;
+    }
+
+    free(buffer);
+    return result;
+}
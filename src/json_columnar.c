@@ -0,0 +1,368 @@
+#include "json_parser.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Columnar (struct-of-arrays) storage for arrays of identically-shaped
+// objects. Instead of millions of JsonValue/JsonObject nodes, each key
+// becomes one typed column — contiguous doubles or bools, or a packed
+// string table — so scanning a field is a sequential array walk instead
+// of a pointer chase. Rows are materialized on demand through
+// json_columnar_row; everything else reads the columns directly.
+
+typedef enum {
+    COLUMN_UNDECIDED,  // only nulls seen so far
+    COLUMN_NUMBER,
+    COLUMN_BOOL,
+    COLUMN_STRING
+} ColumnKind;
+
+typedef struct {
+    char* key;
+    ColumnKind kind;
+    unsigned char* null_bits;  // 1 bit per row, set = JSON null
+    double* numbers;
+    unsigned char* bools;
+    size_t* offsets;           // per-row offset into bytes
+    char* bytes;               // packed NUL-terminated strings
+    size_t bytes_used;
+    size_t bytes_capacity;
+} Column;
+
+struct JsonColumnSet {
+    Column* columns;
+    size_t column_count;
+    size_t row_count;
+};
+
+static void set_null_bit(unsigned char* bits, size_t row) {
+    bits[row >> 3] |= (unsigned char)(1u << (row & 7));
+}
+
+static bool get_null_bit(const unsigned char* bits, size_t row) {
+    return (bits[row >> 3] >> (row & 7)) & 1u;
+}
+
+static bool column_push_string(Column* column, size_t row, const char* str) {
+    size_t len = strlen(str) + 1;
+    if (column->bytes_used + len > column->bytes_capacity) {
+        size_t new_capacity = column->bytes_capacity == 0 ? 1024 : column->bytes_capacity;
+        while (new_capacity < column->bytes_used + len) new_capacity *= 2;
+        char* grown = realloc(column->bytes, new_capacity);
+        if (!grown) return false;
+        column->bytes = grown;
+        column->bytes_capacity = new_capacity;
+    }
+    column->offsets[row] = column->bytes_used;
+    memcpy(column->bytes + column->bytes_used, str, len);
+    column->bytes_used += len;
+    return true;
+}
+
+static bool column_alloc_storage(Column* column, size_t rows) {
+    switch (column->kind) {
+        case COLUMN_NUMBER:
+            column->numbers = calloc(rows, sizeof(double));
+            return column->numbers != NULL;
+        case COLUMN_BOOL:
+            column->bools = calloc(rows, 1);
+            return column->bools != NULL;
+        case COLUMN_STRING:
+            column->offsets = calloc(rows, sizeof(size_t));
+            return column->offsets != NULL;
+        default:
+            return true;
+    }
+}
+
+static ColumnKind kind_for_value(const JsonValue* value) {
+    switch (value->type) {
+        case JSON_NUMBER: return COLUMN_NUMBER;
+        case JSON_BOOL:   return COLUMN_BOOL;
+        case JSON_STRING: return COLUMN_STRING;
+        default:          return COLUMN_UNDECIDED;
+    }
+}
+
+static Column* find_column(const JsonColumnSet* set, const char* key) {
+    for (size_t i = 0; i < set->column_count; i++) {
+        if (set->columns[i].key == key || strcmp(set->columns[i].key, key) == 0) {
+            return &set->columns[i];
+        }
+    }
+    return NULL;
+}
+
+void json_columnar_free(JsonColumnSet* set) {
+    if (!set) return;
+    for (size_t i = 0; i < set->column_count; i++) {
+        free(set->columns[i].key);
+        free(set->columns[i].null_bits);
+        free(set->columns[i].numbers);
+        free(set->columns[i].bools);
+        free(set->columns[i].offsets);
+        free(set->columns[i].bytes);
+    }
+    free(set->columns);
+    free(set);
+}
+
+// Build typed columns from an array of objects that all carry the same
+// keys, in the same order, with consistent scalar types (JSON null is
+// allowed anywhere and tracked in a per-column bitmap). Arrays that do
+// not fit that shape are rejected with JSON_ERROR_INVALID_TYPE — the
+// caller keeps using the tree form. The source array is not consumed.
+JsonColumnSet* json_columnar_from_array(const JsonValue* array) {
+    if (!array) {
+        json_set_error(JSON_ERROR_NULL_POINTER, "Array is NULL", 0, 0);
+        return NULL;
+    }
+    if (array->type != JSON_ARRAY) {
+        json_set_error(JSON_ERROR_INVALID_TYPE, "Not an array", 0, 0);
+        return NULL;
+    }
+
+    JsonArray* arr = array->data.array_value;
+    if (arr->count == 0) {
+        json_set_error(JSON_ERROR_INVALID_TYPE, "Cannot build columns from an empty array", 0, 0);
+        return NULL;
+    }
+
+    JsonValue* first = arr->values[0];
+    if (!first || first->type != JSON_OBJECT || first->data.object_value->count == 0) {
+        json_set_error(JSON_ERROR_INVALID_TYPE, "Array elements are not keyed records", 0, 0);
+        return NULL;
+    }
+
+    JsonObject* schema = first->data.object_value;
+    size_t rows = arr->count;
+    size_t cols = schema->count;
+
+    JsonColumnSet* set = calloc(1, sizeof(JsonColumnSet));
+    if (!set) {
+        json_set_error(JSON_ERROR_OUT_OF_MEMORY, "Failed to allocate column set", 0, 0);
+        return NULL;
+    }
+    set->columns = calloc(cols, sizeof(Column));
+    if (!set->columns) {
+        free(set);
+        json_set_error(JSON_ERROR_OUT_OF_MEMORY, "Failed to allocate columns", 0, 0);
+        return NULL;
+    }
+    set->column_count = cols;
+    set->row_count = rows;
+
+    for (size_t c = 0; c < cols; c++) {
+        Column* column = &set->columns[c];
+        column->key = json_arena_strdup(NULL, schema->pairs[c].key);
+        column->null_bits = calloc((rows + 7) / 8, 1);
+        if (!column->key || !column->null_bits) {
+            json_columnar_free(set);
+            json_set_error(JSON_ERROR_OUT_OF_MEMORY, "Failed to allocate column", 0, 0);
+            return NULL;
+        }
+        column->kind = COLUMN_UNDECIDED;
+    }
+
+    // Two passes: settle each column's kind first, then fill storage —
+    // avoids re-allocating when the first rows of a column are null
+    for (size_t r = 0; r < rows; r++) {
+        JsonValue* row = arr->values[r];
+        if (!row || row->type != JSON_OBJECT || row->data.object_value->count != cols) {
+            json_columnar_free(set);
+            json_set_error(JSON_ERROR_INVALID_TYPE, "Array elements do not share a schema", 0, 0);
+            return NULL;
+        }
+        JsonObject* obj = row->data.object_value;
+        for (size_t c = 0; c < cols; c++) {
+            JsonPair* pair = &obj->pairs[c];
+            Column* column = &set->columns[c];
+            if (pair->key != column->key && strcmp(pair->key, column->key) != 0) {
+                json_columnar_free(set);
+                json_set_error(JSON_ERROR_INVALID_TYPE, "Array elements do not share a schema", 0, 0);
+                return NULL;
+            }
+            ColumnKind kind = kind_for_value(pair->value);
+            if (kind == COLUMN_UNDECIDED) {
+                if (pair->value->type != JSON_NULL) {
+                    json_columnar_free(set);
+                    json_set_error(JSON_ERROR_INVALID_TYPE, "Nested values cannot be columnar", 0, 0);
+                    return NULL;
+                }
+                continue;
+            }
+            if (column->kind == COLUMN_UNDECIDED) {
+                column->kind = kind;
+            } else if (column->kind != kind) {
+                json_columnar_free(set);
+                json_set_error(JSON_ERROR_INVALID_TYPE, "Column has mixed value types", 0, 0);
+                return NULL;
+            }
+        }
+    }
+
+    for (size_t c = 0; c < cols; c++) {
+        // All-null columns degrade to numbers; the bitmap marks every row
+        if (set->columns[c].kind == COLUMN_UNDECIDED) {
+            set->columns[c].kind = COLUMN_NUMBER;
+        }
+        if (!column_alloc_storage(&set->columns[c], rows)) {
+            json_columnar_free(set);
+            json_set_error(JSON_ERROR_OUT_OF_MEMORY, "Failed to allocate column storage", 0, 0);
+            return NULL;
+        }
+    }
+
+    for (size_t r = 0; r < rows; r++) {
+        JsonObject* obj = arr->values[r]->data.object_value;
+        for (size_t c = 0; c < cols; c++) {
+            JsonValue* value = obj->pairs[c].value;
+            Column* column = &set->columns[c];
+            if (value->type == JSON_NULL) {
+                set_null_bit(column->null_bits, r);
+                continue;
+            }
+            switch (column->kind) {
+                case COLUMN_NUMBER:
+                    column->numbers[r] = value->data.number_value;
+                    break;
+                case COLUMN_BOOL:
+                    column->bools[r] = value->data.bool_value ? 1 : 0;
+                    break;
+                case COLUMN_STRING:
+                    if (!column_push_string(column, r, json_string_value(value))) {
+                        json_columnar_free(set);
+                        json_set_error(JSON_ERROR_OUT_OF_MEMORY, "Failed to pack string column", 0, 0);
+                        return NULL;
+                    }
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+
+    return set;
+}
+
+size_t json_columnar_row_count(const JsonColumnSet* set) {
+    return set ? set->row_count : 0;
+}
+
+size_t json_columnar_column_count(const JsonColumnSet* set) {
+    return set ? set->column_count : 0;
+}
+
+const char* json_columnar_key(const JsonColumnSet* set, size_t column) {
+    if (!set || column >= set->column_count) return NULL;
+    return set->columns[column].key;
+}
+
+// Direct view of a numeric column: row_count contiguous doubles (null
+// rows hold 0.0 — check json_columnar_is_null). NULL if the key is
+// missing or the column is not numeric.
+const double* json_columnar_numbers(const JsonColumnSet* set, const char* key) {
+    if (!set || !key) {
+        json_set_error(JSON_ERROR_NULL_POINTER, "Column set or key is NULL", 0, 0);
+        return NULL;
+    }
+    Column* column = find_column(set, key);
+    if (!column) {
+        json_set_error(JSON_ERROR_KEY_NOT_FOUND, key, 0, 0);
+        return NULL;
+    }
+    if (column->kind != COLUMN_NUMBER) {
+        json_set_error(JSON_ERROR_INVALID_TYPE, "Not a numeric column", 0, 0);
+        return NULL;
+    }
+    return column->numbers;
+}
+
+const unsigned char* json_columnar_bools(const JsonColumnSet* set, const char* key) {
+    if (!set || !key) {
+        json_set_error(JSON_ERROR_NULL_POINTER, "Column set or key is NULL", 0, 0);
+        return NULL;
+    }
+    Column* column = find_column(set, key);
+    if (!column) {
+        json_set_error(JSON_ERROR_KEY_NOT_FOUND, key, 0, 0);
+        return NULL;
+    }
+    if (column->kind != COLUMN_BOOL) {
+        json_set_error(JSON_ERROR_INVALID_TYPE, "Not a boolean column", 0, 0);
+        return NULL;
+    }
+    return column->bools;
+}
+
+const char* json_columnar_string_at(const JsonColumnSet* set, const char* key, size_t row) {
+    if (!set || !key) {
+        json_set_error(JSON_ERROR_NULL_POINTER, "Column set or key is NULL", 0, 0);
+        return NULL;
+    }
+    if (row >= set->row_count) {
+        json_set_error(JSON_ERROR_INDEX_OUT_OF_BOUNDS, "Row out of bounds", 0, 0);
+        return NULL;
+    }
+    Column* column = find_column(set, key);
+    if (!column) {
+        json_set_error(JSON_ERROR_KEY_NOT_FOUND, key, 0, 0);
+        return NULL;
+    }
+    if (column->kind != COLUMN_STRING) {
+        json_set_error(JSON_ERROR_INVALID_TYPE, "Not a string column", 0, 0);
+        return NULL;
+    }
+    if (get_null_bit(column->null_bits, row)) return NULL;
+    return column->bytes + column->offsets[row];
+}
+
+bool json_columnar_is_null(const JsonColumnSet* set, const char* key, size_t row) {
+    if (!set || !key || row >= set->row_count) return false;
+    Column* column = find_column(set, key);
+    return column ? get_null_bit(column->null_bits, row) : false;
+}
+
+// Materialize one record as a regular JsonValue object (caller frees) —
+// the cursor-style bridge back to the tree API for code that needs it.
+JsonValue* json_columnar_row(const JsonColumnSet* set, size_t row) {
+    if (!set) {
+        json_set_error(JSON_ERROR_NULL_POINTER, "Column set is NULL", 0, 0);
+        return NULL;
+    }
+    if (row >= set->row_count) {
+        json_set_error(JSON_ERROR_INDEX_OUT_OF_BOUNDS, "Row out of bounds", 0, 0);
+        return NULL;
+    }
+
+    JsonValue* object = json_create_object();
+    if (!object) return NULL;
+
+    for (size_t c = 0; c < set->column_count; c++) {
+        Column* column = &set->columns[c];
+        JsonValue* value;
+        if (get_null_bit(column->null_bits, row)) {
+            value = json_create_null();
+        } else {
+            switch (column->kind) {
+                case COLUMN_NUMBER:
+                    value = json_create_number(column->numbers[row]);
+                    break;
+                case COLUMN_BOOL:
+                    value = json_create_bool(column->bools[row] != 0);
+                    break;
+                case COLUMN_STRING:
+                    value = json_create_string(column->bytes + column->offsets[row]);
+                    break;
+                default:
+                    value = json_create_null();
+                    break;
+            }
+        }
+        if (!value || !json_object_set(object, column->key, value)) {
+            json_free(value);
+            json_free(object);
+            return NULL;
+        }
+    }
+    return object;
+}
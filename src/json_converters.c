@@ -143,7 +143,7 @@ static bool json_to_xml_recursive(ConvertContext* ctx, const JsonValue* value, c
             break;
         }
         case JSON_STRING:
-            if (!xml_escape(ctx, value->data.string_value)) return false;
+            if (!xml_escape(ctx, json_string_value(value))) return false;
             break;
         case JSON_ARRAY: {
             if (!append_char_conv(ctx, '\n')) return false;
@@ -240,7 +240,7 @@ static bool json_to_yaml_recursive(ConvertContext* ctx, const JsonValue* value,
         }
         case JSON_STRING: {
             bool needs_quotes = false;
-            const char* str = value->data.string_value;
+            const char* str = json_string_value(value);
             
             if (strlen(str) == 0) {
                 needs_quotes = true;
@@ -464,7 +464,7 @@ char* json_to_csv(const JsonValue* value) {
                 bool needs_quotes = false;
                 
                 if (val->type == JSON_STRING) {
-                    const char* str = val->data.string_value;
+                    const char* str = json_string_value(val);
                     if (strchr(str, ',') || strchr(str, '"') || strchr(str, '\n') || strchr(str, '\r')) {
                         needs_quotes = true;
                     }
@@ -512,6 +512,110 @@ error:
     return NULL;
 }
 
+char* json_to_csv_r(const JsonValue* value, JsonError* error) {
+    char* result = json_to_csv(value);
+    if (error) *error = *json_get_last_error();
+    return result;
+}
+
+// One CSV field with the same quoting rules as json_to_csv
+static bool csv_write_field(FILE* file, const char* str) {
+    bool needs_quotes = strchr(str, ',') || strchr(str, '"') ||
+                        strchr(str, '\n') || strchr(str, '\r');
+    if (!needs_quotes) {
+        return fputs(str, file) >= 0;
+    }
+
+    if (fputc('"', file) == EOF) return false;
+    for (const char* p = str; *p; p++) {
+        if (*p == '"' && fputc('"', file) == EOF) return false;
+        if (fputc(*p, file) == EOF) return false;
+    }
+    return fputc('"', file) != EOF;
+}
+
+static bool csv_write_value(FILE* file, const JsonValue* val) {
+    if (!val) return true;
+
+    switch (val->type) {
+        case JSON_STRING:
+            return csv_write_field(file, json_string_value(val));
+        case JSON_NUMBER: {
+            char num[128];
+            if (val->data.number_value == (long long)val->data.number_value) {
+                snprintf(num, sizeof(num), "%lld", (long long)val->data.number_value);
+            } else {
+                snprintf(num, sizeof(num), "%.17g", val->data.number_value);
+            }
+            return fputs(num, file) >= 0;
+        }
+        case JSON_BOOL:
+            return fputs(val->data.bool_value ? "true" : "false", file) >= 0;
+        default:
+            // Empty field for null and non-scalar values
+            return true;
+    }
+}
+
+// Streaming counterpart of json_to_csv: rows are written to the file as
+// they are visited, so output never accumulates in memory. Produces the
+// same bytes as json_to_csv for the same input.
+bool json_array_to_csv_file(const JsonValue* value, const char* filename) {
+    if (!value || !filename) {
+        json_set_error(JSON_ERROR_NULL_POINTER, "Value or filename is NULL", 0, 0);
+        return false;
+    }
+
+    if (value->type != JSON_ARRAY) {
+        json_set_error(JSON_ERROR_INVALID_TYPE, "CSV conversion requires array of objects", 0, 0);
+        return false;
+    }
+
+    JsonArray* arr = value->data.array_value;
+    if (arr->count == 0 || arr->values[0]->type != JSON_OBJECT) {
+        json_set_error(JSON_ERROR_INVALID_TYPE, "CSV conversion requires array of objects", 0, 0);
+        return false;
+    }
+
+    FILE* file = fopen(filename, "w");
+    if (!file) {
+        char error_msg[512];
+        snprintf(error_msg, sizeof(error_msg), "Cannot open file for writing: %s", filename);
+        json_set_error(JSON_ERROR_FILE_WRITE_ERROR, error_msg, 0, 0);
+        return false;
+    }
+
+    JsonObject* first_obj = arr->values[0]->data.object_value;
+
+    for (size_t i = 0; i < first_obj->count; i++) {
+        if (!csv_write_field(file, first_obj->pairs[i].key)) goto write_error;
+        if (i < first_obj->count - 1 && fputc(',', file) == EOF) goto write_error;
+    }
+    if (fputc('\n', file) == EOF) goto write_error;
+
+    for (size_t row = 0; row < arr->count; row++) {
+        if (arr->values[row]->type != JSON_OBJECT) continue;
+
+        for (size_t col = 0; col < first_obj->count; col++) {
+            JsonValue* val = json_object_get(arr->values[row], first_obj->pairs[col].key);
+            if (!csv_write_value(file, val)) goto write_error;
+            if (col < first_obj->count - 1 && fputc(',', file) == EOF) goto write_error;
+        }
+        if (fputc('\n', file) == EOF) goto write_error;
+    }
+
+    if (fclose(file) != 0) {
+        json_set_error(JSON_ERROR_FILE_WRITE_ERROR, "Failed to close CSV file", 0, 0);
+        return false;
+    }
+    return true;
+
+write_error:
+    json_set_error(JSON_ERROR_FILE_WRITE_ERROR, "Failed to write CSV file", 0, 0);
+    fclose(file);
+    return false;
+}
+
 char* json_to_ini(const JsonValue* value) {
     if (!value) {
         json_set_error(JSON_ERROR_NULL_POINTER, "Cannot convert NULL to INI", 0, 0);
@@ -556,7 +660,7 @@ char* json_to_ini(const JsonValue* value) {
                 
                 JsonValue* val = section->pairs[j].value;
                 if (val->type == JSON_STRING) {
-                    const char* str = val->data.string_value;
+                    const char* str = json_string_value(val);
                     bool needs_quotes = strchr(str, '\n') || strchr(str, '\r') || strchr(str, ';') || strchr(str, '#');
                     if (needs_quotes) {
                         if (!append_char_conv(&ctx, '"')) goto error;
@@ -583,7 +687,7 @@ char* json_to_ini(const JsonValue* value) {
         } else if (section_val->type == JSON_STRING) {
             if (!append_conv(&ctx, obj->pairs[i].key)) goto error;
             if (!append_char_conv(&ctx, '=')) goto error;
-            if (!append_conv(&ctx, section_val->data.string_value)) goto error;
+            if (!append_conv(&ctx, json_string_value(section_val))) goto error;
             if (!append_char_conv(&ctx, '\n')) goto error;
         }
         
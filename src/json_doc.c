@@ -0,0 +1,288 @@
+#include "json_parser.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#ifdef __x86_64__
+#include <immintrin.h>
+#define SIMD_AVAILABLE 1
+#else
+#define SIMD_AVAILABLE 0
+#endif
+
+// Two-stage lazy engine for field extraction. Stage one sweeps the raw
+// buffer once and records a structural tape: the offset of every brace,
+// bracket, colon, comma and opening string quote outside of strings.
+// Stage two (json_doc_find) walks the tape to locate a key and runs the
+// real parser only on that value's byte span, so untouched fields are
+// never tokenized or materialized.
+
+struct JsonDoc {
+    const char* buffer;
+    size_t length;
+    size_t* tape;       // offsets of structural bytes, in buffer order
+    size_t tape_count;
+    size_t tape_capacity;
+};
+
+static bool tape_push(JsonDoc* doc, size_t offset) {
+    if (doc->tape_count == doc->tape_capacity) {
+        size_t new_capacity = doc->tape_capacity ? doc->tape_capacity * 2 : 256;
+        size_t* resized = realloc(doc->tape, new_capacity * sizeof(size_t));
+        if (!resized) {
+            json_set_error(JSON_ERROR_OUT_OF_MEMORY, "Failed to grow structural tape", 0, 0);
+            return false;
+        }
+        doc->tape = resized;
+        doc->tape_capacity = new_capacity;
+    }
+    doc->tape[doc->tape_count++] = offset;
+    return true;
+}
+
+#if SIMD_AVAILABLE
+// Find the next structural byte or quote/backslash; everything in
+// between is scalar or whitespace content the tape does not record.
+static const char* scan_structural_sse2(const char* ptr, const char* end) {
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i lbrace = _mm_set1_epi8('{');
+    const __m128i rbrace = _mm_set1_epi8('}');
+    const __m128i lbracket = _mm_set1_epi8('[');
+    const __m128i rbracket = _mm_set1_epi8(']');
+    const __m128i colon = _mm_set1_epi8(':');
+    const __m128i comma = _mm_set1_epi8(',');
+
+    while (ptr + 16 <= end) {
+        __m128i chunk = _mm_loadu_si128((const __m128i*)ptr);
+        __m128i hit = _mm_or_si128(
+            _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash)),
+                _mm_or_si128(_mm_cmpeq_epi8(chunk, lbrace), _mm_cmpeq_epi8(chunk, rbrace))),
+            _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi8(chunk, lbracket), _mm_cmpeq_epi8(chunk, rbracket)),
+                _mm_or_si128(_mm_cmpeq_epi8(chunk, colon), _mm_cmpeq_epi8(chunk, comma))));
+
+        int mask = _mm_movemask_epi8(hit);
+        if (mask != 0) {
+            return ptr + __builtin_ctz(mask);
+        }
+        ptr += 16;
+    }
+    return ptr;
+}
+#endif
+
+static bool is_structural(char c) {
+    return c == '{' || c == '}' || c == '[' || c == ']' ||
+           c == ':' || c == ',' || c == '"' || c == '\\';
+}
+
+static const char* scan_structural(const char* ptr, const char* end) {
+#if SIMD_AVAILABLE
+    ptr = scan_structural_sse2(ptr, end);
+#endif
+    while (ptr < end && !is_structural(*ptr)) ptr++;
+    return ptr;
+}
+
+#if SIMD_AVAILABLE
+static const char* scan_quote_sse2(const char* ptr, const char* end) {
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+
+    while (ptr + 16 <= end) {
+        __m128i chunk = _mm_loadu_si128((const __m128i*)ptr);
+        int mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(chunk, quote),
+                                                  _mm_cmpeq_epi8(chunk, backslash)));
+        if (mask != 0) {
+            return ptr + __builtin_ctz(mask);
+        }
+        ptr += 16;
+    }
+    return ptr;
+}
+#endif
+
+// Skip past a string literal starting at its opening quote. Returns the
+// position just after the closing quote, or NULL if unterminated.
+// Contents are not validated here; that happens if the span is parsed.
+static const char* skip_string(const char* ptr, const char* end) {
+    ptr++;
+    while (ptr < end) {
+#if SIMD_AVAILABLE
+        ptr = scan_quote_sse2(ptr, end);
+#endif
+        while (ptr < end && *ptr != '"' && *ptr != '\\') ptr++;
+        if (ptr >= end) break;
+        if (*ptr == '"') return ptr + 1;
+        ptr += 2;  // escape: skip backslash and the escaped byte
+    }
+    return NULL;
+}
+
+JsonDoc* json_doc_open(const char* buffer, size_t length) {
+    if (!buffer) {
+        json_set_error(JSON_ERROR_NULL_POINTER, "Buffer is NULL", 0, 0);
+        return NULL;
+    }
+
+    JsonDoc* doc = calloc(1, sizeof(JsonDoc));
+    if (!doc) {
+        json_set_error(JSON_ERROR_OUT_OF_MEMORY, "Failed to allocate document", 0, 0);
+        return NULL;
+    }
+    doc->buffer = buffer;
+    doc->length = length;
+
+    const char* start = buffer;
+    const char* end = buffer + length;
+    const char* p = start;
+
+    while (p < end) {
+        p = scan_structural(p, end);
+        if (p >= end) break;
+
+        if (*p == '"') {
+            if (!tape_push(doc, (size_t)(p - start))) goto fail;
+            p = skip_string(p, end);
+            if (!p) {
+                json_set_error(JSON_ERROR_UNTERMINATED_STRING, "Unterminated string", 0, 0);
+                goto fail;
+            }
+        } else if (*p == '\\') {
+            json_set_error(JSON_ERROR_INVALID_SYNTAX, "Unexpected escape outside string", 0, 0);
+            goto fail;
+        } else {
+            if (!tape_push(doc, (size_t)(p - start))) goto fail;
+            p++;
+        }
+    }
+
+    return doc;
+
+fail:
+    json_doc_close(doc);
+    return NULL;
+}
+
+void json_doc_close(JsonDoc* doc) {
+    if (!doc) return;
+    free(doc->tape);
+    free(doc);
+}
+
+// Advance past the value whose first tape entry is at *index. On return
+// *index is the entry after the value (a ',' or closing bracket for
+// well-formed input). For scalars, which leave no tape entry, *index is
+// already the terminator and is left alone.
+static bool skip_value_entries(const JsonDoc* doc, size_t* index) {
+    if (*index >= doc->tape_count) return false;
+
+    char c = doc->buffer[doc->tape[*index]];
+    if (c == '"') {
+        (*index)++;
+        return true;
+    }
+    if (c == '{' || c == '[') {
+        size_t depth = 0;
+        while (*index < doc->tape_count) {
+            char t = doc->buffer[doc->tape[*index]];
+            if (t == '{' || t == '[') depth++;
+            else if (t == '}' || t == ']') {
+                depth--;
+                if (depth == 0) {
+                    (*index)++;
+                    return true;
+                }
+            }
+            (*index)++;
+        }
+        return false;
+    }
+    // Scalar: no entries of its own.
+    return true;
+}
+
+JsonValue* json_doc_find(const JsonDoc* doc, const char* key) {
+    if (!doc || !key) {
+        json_set_error(JSON_ERROR_NULL_POINTER, "Document or key is NULL", 0, 0);
+        return NULL;
+    }
+    if (doc->tape_count == 0 || doc->buffer[doc->tape[0]] != '{') {
+        json_set_error(JSON_ERROR_INVALID_TYPE, "Document root is not an object", 0, 0);
+        return NULL;
+    }
+
+    size_t key_len = strlen(key);
+    const char* buf = doc->buffer;
+    const char* end = buf + doc->length;
+    size_t i = 1;
+
+    while (i < doc->tape_count) {
+        char c = buf[doc->tape[i]];
+        if (c == '}') break;
+        if (c != '"') {
+            json_set_error(JSON_ERROR_INVALID_SYNTAX, "Expected object key", 0, 0);
+            return NULL;
+        }
+
+        const char* key_start = buf + doc->tape[i] + 1;
+        const char* key_close = skip_string(buf + doc->tape[i], end);
+        if (!key_close) {
+            json_set_error(JSON_ERROR_UNTERMINATED_STRING, "Unterminated key", 0, 0);
+            return NULL;
+        }
+        size_t raw_len = (size_t)(key_close - 1 - key_start);
+        // Keys are compared against the raw bytes of the literal; keys
+        // containing escapes only match their escaped spelling.
+        bool match = raw_len == key_len && memcmp(key_start, key, key_len) == 0;
+
+        i++;
+        if (i >= doc->tape_count || buf[doc->tape[i]] != ':') {
+            json_set_error(JSON_ERROR_INVALID_SYNTAX, "Expected ':' after key", 0, 0);
+            return NULL;
+        }
+        size_t colon_offset = doc->tape[i];
+        i++;
+
+        size_t value_index = i;
+        if (!skip_value_entries(doc, &i)) {
+            json_set_error(JSON_ERROR_UNEXPECTED_EOF, "Unterminated value", 0, 0);
+            return NULL;
+        }
+
+        if (match) {
+            const char* value_start;
+            const char* value_end;
+            char vc = value_index < doc->tape_count ? buf[doc->tape[value_index]] : '\0';
+            if (vc == '"') {
+                value_start = buf + doc->tape[value_index];
+                value_end = skip_string(value_start, end);
+                if (!value_end) {
+                    json_set_error(JSON_ERROR_UNTERMINATED_STRING, "Unterminated string", 0, 0);
+                    return NULL;
+                }
+            } else if (vc == '{' || vc == '[') {
+                value_start = buf + doc->tape[value_index];
+                // i now sits one past the matching close bracket
+                value_end = buf + doc->tape[i - 1] + 1;
+            } else {
+                // Scalar: runs from after the colon to the terminator
+                if (i >= doc->tape_count) {
+                    json_set_error(JSON_ERROR_UNEXPECTED_EOF, "Unterminated value", 0, 0);
+                    return NULL;
+                }
+                value_start = buf + colon_offset + 1;
+                value_end = buf + doc->tape[i];
+            }
+            return json_parse_buffer(value_start, (size_t)(value_end - value_start));
+        }
+
+        // Step over the ',' separator; '}' ends the object.
+        if (i < doc->tape_count && buf[doc->tape[i]] == ',') i++;
+    }
+
+    json_set_error(JSON_ERROR_KEY_NOT_FOUND, "Key not found", 0, 0);
+    return NULL;
+}
@@ -1,14 +1,28 @@
+#ifndef _WIN32
+#define _GNU_SOURCE
+#endif
+
 #include "json_parser.h"
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
 
-JsonValue* json_parse_file(const char* filename) {
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#define MMAP_AVAILABLE 1
+#else
+#define MMAP_AVAILABLE 0
+#endif
+
+JsonValue* json_parse_file_limit(const char* filename, size_t max_size) {
     if (!filename) {
         json_set_error(JSON_ERROR_NULL_POINTER, "Filename is NULL", 0, 0);
         return NULL;
     }
-    
+
     FILE* file = fopen(filename, "r");
     if (!file) {
         char error_msg[512];
@@ -36,12 +50,14 @@ JsonValue* json_parse_file(const char* filename) {
         return NULL;
     }
     
-    if (size > 100 * 1024 * 1024) {
-        json_set_error(JSON_ERROR_FILE_READ_ERROR, "File too large (>100MB)", 0, 0);
+    if (max_size > 0 && (size_t)size > max_size) {
+        char error_msg[512];
+        snprintf(error_msg, sizeof(error_msg), "File exceeds caller limit of %zu bytes", max_size);
+        json_set_error(JSON_ERROR_FILE_READ_ERROR, error_msg, 0, 0);
         fclose(file);
         return NULL;
     }
-    
+
     if (fseek(file, 0, SEEK_SET) != 0) {
         json_set_error(JSON_ERROR_FILE_READ_ERROR, "Cannot seek to start of file", 0, 0);
         fclose(file);
@@ -76,21 +92,150 @@ JsonValue* json_parse_file(const char* filename) {
         snprintf(error_msg, sizeof(error_msg), "Failed to parse JSON from file: %s", filename);
         json_set_error(JSON_ERROR_INVALID_SYNTAX, error_msg, 0, 0);
     }
-    
+
     return result;
 }
 
-bool json_save_file(const char* filename, const JsonValue* value, bool pretty) {
+JsonValue* json_parse_file(const char* filename) {
+    return json_parse_file_limit(filename, 0);
+}
+
+JsonValue* json_parse_file_r(const char* filename, JsonError* error) {
+    JsonValue* result = json_parse_file(filename);
+    if (error) *error = *json_get_last_error();
+    return result;
+}
+
+bool json_mmap_open(const char* filename, JsonMappedFile* map) {
+    if (!filename || !map) {
+        json_set_error(JSON_ERROR_NULL_POINTER, "Filename or map is NULL", 0, 0);
+        return false;
+    }
+
+    map->data = NULL;
+    map->size = 0;
+
+#if MMAP_AVAILABLE
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) {
+        char error_msg[512];
+        snprintf(error_msg, sizeof(error_msg), "Cannot open file: %s", filename);
+        json_set_error(JSON_ERROR_FILE_NOT_FOUND, error_msg, 0, 0);
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        json_set_error(JSON_ERROR_FILE_READ_ERROR, "Cannot stat file or file is empty", 0, 0);
+        close(fd);
+        return false;
+    }
+    size_t size = (size_t)st.st_size;
+
+    // Private copy-on-write mapping: the in-situ parser may unescape
+    // strings in place without touching the file. Map one extra byte so
+    // the tokenizer always sees a NUL terminator; when the file size is
+    // an exact multiple of the page size, pin a zeroed page behind it.
+    char* data = mmap(NULL, size + 1, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        json_set_error(JSON_ERROR_FILE_READ_ERROR, "mmap failed", 0, 0);
+        return false;
+    }
+
+    long page_size = sysconf(_SC_PAGESIZE);
+    if (page_size > 0 && size % (size_t)page_size == 0) {
+        void* tail = mmap(data + size, (size_t)page_size, PROT_READ | PROT_WRITE,
+                          MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED, -1, 0);
+        if (tail == MAP_FAILED) {
+            munmap(data, size + 1);
+            json_set_error(JSON_ERROR_FILE_READ_ERROR, "mmap failed", 0, 0);
+            return false;
+        }
+    }
+    data[size] = '\0';
+
+    madvise(data, size, MADV_SEQUENTIAL);
+
+    map->data = data;
+    map->size = size;
+    return true;
+#else
+    json_set_error(JSON_ERROR_FILE_READ_ERROR, "mmap not available on this platform", 0, 0);
+    return false;
+#endif
+}
+
+void json_mmap_close(JsonMappedFile* map) {
+    if (!map || !map->data) return;
+#if MMAP_AVAILABLE
+    munmap(map->data, map->size + 1);
+#endif
+    map->data = NULL;
+    map->size = 0;
+}
+
+JsonValue* json_parse_file_mmap(const char* filename) {
+#if MMAP_AVAILABLE
+    JsonMappedFile map;
+    if (!json_mmap_open(filename, &map)) {
+        return NULL;
+    }
+
+    // Strings are copied out of the mapping here; callers that want
+    // zero-copy views should json_mmap_open themselves, run
+    // json_parse_insitu(map.data) and keep the mapping alive
+    JsonValue* result = json_parse(map.data);
+    json_mmap_close(&map);
+
+    if (!result) {
+        char error_msg[512];
+        snprintf(error_msg, sizeof(error_msg), "Failed to parse JSON from file: %s", filename);
+        json_set_error(JSON_ERROR_INVALID_SYNTAX, error_msg, 0, 0);
+    }
+    return result;
+#else
+    return json_parse_file(filename);
+#endif
+}
+
+static bool file_write_sink(const char* data, size_t length, void* user_data) {
+    FILE* file = user_data;
+    if (fwrite(data, 1, length, file) != length) {
+        json_set_error(JSON_ERROR_FILE_WRITE_ERROR, "Failed to write JSON to stream", 0, 0);
+        return false;
+    }
+    return true;
+}
+
+bool json_write_stream(FILE* file, const JsonValue* value, bool pretty) {
+    if (!file) {
+        json_set_error(JSON_ERROR_NULL_POINTER, "Output stream is NULL", 0, 0);
+        return false;
+    }
+
+    if (!value) {
+        json_set_error(JSON_ERROR_NULL_POINTER, "Value to save is NULL", 0, 0);
+        return false;
+    }
+
+    // The serializer flushes each full 64KB block straight into the
+    // stream, so memory stays O(depth) instead of O(output)
+    JsonWriteConfig config = {pretty, 2, 0, 0};
+    return json_stringify_to_sink(value, &config, file_write_sink, file, NULL);
+}
+
+bool json_write_file(const char* filename, const JsonValue* value, bool pretty) {
     if (!filename) {
         json_set_error(JSON_ERROR_NULL_POINTER, "Filename is NULL", 0, 0);
         return false;
     }
-    
+
     if (!value) {
         json_set_error(JSON_ERROR_NULL_POINTER, "Value to save is NULL", 0, 0);
         return false;
     }
-    
+
     FILE* file = fopen(filename, "w");
     if (!file) {
         char error_msg[512];
@@ -98,28 +243,26 @@ bool json_save_file(const char* filename, const JsonValue* value, bool pretty) {
         json_set_error(JSON_ERROR_FILE_WRITE_ERROR, error_msg, 0, 0);
         return false;
     }
-    
-    char* json_str = json_stringify(value, pretty);
-    if (!json_str) {
-        fclose(file);
-        json_set_error(JSON_ERROR_CONVERSION_FAILED, "Failed to stringify JSON", 0, 0);
-        return false;
-    }
-    
-    size_t len = strlen(json_str);
-    size_t written = fprintf(file, "%s", json_str);
-    free(json_str);
-    
-    if (written != len) {
+
+    if (!json_write_stream(file, value, pretty)) {
         fclose(file);
-        json_set_error(JSON_ERROR_FILE_WRITE_ERROR, "Failed to write complete JSON to file", 0, 0);
         return false;
     }
-    
+
     if (fclose(file) != 0) {
         json_set_error(JSON_ERROR_FILE_WRITE_ERROR, "Failed to close file properly", 0, 0);
         return false;
     }
-    
+
     return true;
 }
+
+bool json_save_file(const char* filename, const JsonValue* value, bool pretty) {
+    return json_write_file(filename, value, pretty);
+}
+
+bool json_save_file_r(const char* filename, const JsonValue* value, bool pretty, JsonError* error) {
+    bool ok = json_write_file(filename, value, pretty);
+    if (error) *error = *json_get_last_error();
+    return ok;
+}
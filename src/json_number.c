@@ -0,0 +1,169 @@
+#include "json_parser.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <math.h>
+#include <errno.h>
+
+// Dedicated number kernel: metrics-style documents are dominated by
+// numbers, and both snprintf("%g") on output and strtod on input are
+// far slower than the common cases deserve.
+
+static const char DIGIT_PAIRS[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+// Powers of ten exactly representable in a double (10^0 .. 10^22)
+static const double POW10_EXACT[23] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10,
+    1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+static char* write_u64(uint64_t v, char* out) {
+    char tmp[20];
+    int pos = 20;
+
+    while (v >= 100) {
+        unsigned idx = (unsigned)(v % 100) * 2;
+        v /= 100;
+        tmp[--pos] = DIGIT_PAIRS[idx + 1];
+        tmp[--pos] = DIGIT_PAIRS[idx];
+    }
+    if (v >= 10) {
+        unsigned idx = (unsigned)v * 2;
+        tmp[--pos] = DIGIT_PAIRS[idx + 1];
+        tmp[--pos] = DIGIT_PAIRS[idx];
+    } else {
+        tmp[--pos] = (char)('0' + v);
+    }
+
+    memcpy(out, tmp + pos, (size_t)(20 - pos));
+    return out + (20 - pos);
+}
+
+size_t json_number_format(double value, char* buffer) {
+    if (isnan(value) || isinf(value)) {
+        memcpy(buffer, "null", 5);
+        return 4;
+    }
+
+    // Integer fast path: every integer up to 2^53 prints exactly with
+    // a pair-table itoa, no printf machinery involved
+    if (value >= -9007199254740992.0 && value <= 9007199254740992.0 &&
+        value == (double)(long long)value) {
+        long long i = (long long)value;
+        char* p = buffer;
+        uint64_t u;
+        if (i < 0) {
+            *p++ = '-';
+            u = (uint64_t)(-i);
+        } else {
+            u = (uint64_t)i;
+        }
+        p = write_u64(u, p);
+        *p = '\0';
+        return (size_t)(p - buffer);
+    }
+
+    // Shortest round-trip: most doubles survive 15 significant digits,
+    // so try the short forms first and only pay for 17 when needed
+    for (int precision = 15; precision < 17; precision++) {
+        int n = snprintf(buffer, JSON_NUMBER_BUFFER_SIZE, "%.*g", precision, value);
+        if (strtod(buffer, NULL) == value) return (size_t)n;
+    }
+    return (size_t)snprintf(buffer, JSON_NUMBER_BUFFER_SIZE, "%.17g", value);
+}
+
+// Eight ASCII digits at once: SWAR check and conversion on a 64-bit load
+static inline bool is_eight_digits(const char* p) {
+    uint64_t val;
+    memcpy(&val, p, 8);
+    return ((val & 0xF0F0F0F0F0F0F0F0ULL) |
+            (((val + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4))
+           == 0x3333333333333333ULL;
+}
+
+static inline uint32_t parse_eight_digits(const char* p) {
+    uint64_t val;
+    memcpy(&val, p, 8);
+    val = (val & 0x0F0F0F0F0F0F0F0FULL) * 2561 >> 8;
+    val = (val & 0x00FF00FF00FF00FFULL) * 6553601 >> 16;
+    return (uint32_t)((val & 0x0000FFFF0000FFFFULL) * 42949672960001ULL >> 32);
+}
+
+// Convert an already-validated number token in [start, end). The fast
+// path covers plain integers and decimals whose mantissa fits a double
+// exactly (Clinger: mantissa < 2^53 and scale within the exact power
+// table gives a correctly-rounded single division). Everything else —
+// exponents, long mantissas, overflow — falls back to strtod.
+bool json_number_parse(const char* start, const char* end, double* out) {
+    const char* p = start;
+    bool negative = false;
+
+    if (p < end && *p == '-') {
+        negative = true;
+        p++;
+    }
+
+    uint64_t mantissa = 0;
+    int digits = 0;
+    int frac_digits = 0;
+
+    while (end - p >= 8 && digits + 8 <= 15 && is_eight_digits(p)) {
+        mantissa = mantissa * 100000000 + parse_eight_digits(p);
+        p += 8;
+        digits += 8;
+    }
+    while (p < end && *p >= '0' && *p <= '9') {
+        if (digits >= 15) goto fallback;
+        mantissa = mantissa * 10 + (uint64_t)(*p - '0');
+        p++;
+        digits++;
+    }
+
+    if (p < end && *p == '.') {
+        p++;
+        while (end - p >= 8 && digits + 8 <= 15 && is_eight_digits(p)) {
+            mantissa = mantissa * 100000000 + parse_eight_digits(p);
+            p += 8;
+            digits += 8;
+            frac_digits += 8;
+        }
+        while (p < end && *p >= '0' && *p <= '9') {
+            if (digits >= 15) goto fallback;
+            mantissa = mantissa * 10 + (uint64_t)(*p - '0');
+            p++;
+            digits++;
+            frac_digits++;
+        }
+    }
+
+    if (p < end) goto fallback;
+
+    {
+        double result = (double)mantissa;
+        if (frac_digits > 0) {
+            result /= POW10_EXACT[frac_digits];
+        }
+        *out = negative ? -result : result;
+        return true;
+    }
+
+fallback:
+    errno = 0;
+    double value = strtod(start, NULL);
+    if (errno == ERANGE) {
+        return false;
+    }
+    *out = value;
+    return true;
+}
@@ -0,0 +1,262 @@
+#include "json_parser.h"
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#define PARALLEL_MIN_ELEMENTS 64
+
+typedef struct {
+    const char* start;
+    size_t length;
+} ElementRange;
+
+typedef struct {
+    ElementRange* ranges;
+    size_t count;
+    size_t capacity;
+} ElementList;
+
+typedef struct {
+    const ElementRange* ranges;
+    JsonValue** results;
+    size_t begin;
+    size_t end;
+    bool failed;
+} ParallelWorker;
+
+static bool element_list_push(ElementList* list, const char* start, size_t length) {
+    if (list->count >= list->capacity) {
+        size_t new_capacity = list->capacity == 0 ? 256 : list->capacity * 2;
+        ElementRange* fresh = realloc(list->ranges, new_capacity * sizeof(ElementRange));
+        if (!fresh) return false;
+        list->ranges = fresh;
+        list->capacity = new_capacity;
+    }
+    list->ranges[list->count].start = start;
+    list->ranges[list->count].length = length;
+    list->count++;
+    return true;
+}
+
+// Skip over a string literal, escape-aware; returns pointer past the
+// closing quote or end on unterminated input
+static const char* skip_string_raw(const char* p, const char* end) {
+    p++;
+    while (p < end) {
+        if (*p == '\\') {
+            p += 2;
+        } else if (*p == '"') {
+            return p + 1;
+        } else {
+            p++;
+        }
+    }
+    return end;
+}
+
+// Split the elements of a top-level array without building anything:
+// track bracket depth, skip strings, cut at depth-zero commas
+static bool split_array_elements(const char* p, const char* end, ElementList* list) {
+    int depth = 0;
+    const char* element_start = NULL;
+
+    while (p < end) {
+        char c = *p;
+        if (c == '"') {
+            if (!element_start) element_start = p;
+            p = skip_string_raw(p, end);
+            continue;
+        }
+        if (c == '{' || c == '[') {
+            if (!element_start) element_start = p;
+            depth++;
+        } else if (c == '}' || c == ']') {
+            if (depth == 0) {
+                // Closing bracket of the outer array
+                if (element_start) {
+                    if (!element_list_push(list, element_start, p - element_start)) {
+                        return false;
+                    }
+                }
+                // Anything but trailing whitespace means this is not a
+                // single array document; fail the split so the sequential
+                // parser rejects it with a proper error
+                for (p++; p < end; p++) {
+                    if (*p != ' ' && *p != '\t' && *p != '\n' && *p != '\r') {
+                        return false;
+                    }
+                }
+                return true;
+            }
+            depth--;
+        } else if (c == ',' && depth == 0) {
+            if (!element_start) return false;
+            if (!element_list_push(list, element_start, p - element_start)) return false;
+            element_start = NULL;
+        } else if (!element_start && c != ' ' && c != '\t' && c != '\n' && c != '\r') {
+            element_start = p;
+        }
+        p++;
+    }
+    return false;
+}
+
+// Newline-delimited records: one element per non-blank line
+static bool split_ndjson_records(const char* p, const char* end, ElementList* list) {
+    while (p < end) {
+        const char* line_start = p;
+        while (p < end && *p != '\n') p++;
+
+        const char* line_end = p;
+        while (line_start < line_end &&
+               (*line_start == ' ' || *line_start == '\t' || *line_start == '\r')) {
+            line_start++;
+        }
+        while (line_end > line_start &&
+               (line_end[-1] == ' ' || line_end[-1] == '\t' || line_end[-1] == '\r')) {
+            line_end--;
+        }
+
+        if (line_end > line_start) {
+            if (!element_list_push(list, line_start, line_end - line_start)) return false;
+        }
+        if (p < end) p++;
+    }
+    return list->count > 0;
+}
+
+static void* parallel_worker(void* arg) {
+    ParallelWorker* worker = arg;
+
+    for (size_t i = worker->begin; i < worker->end; i++) {
+        worker->results[i] = json_parse_buffer(worker->ranges[i].start, worker->ranges[i].length);
+        if (!worker->results[i]) {
+            worker->failed = true;
+            return NULL;
+        }
+    }
+    return NULL;
+}
+
+static JsonValue* stitch_results(JsonValue** results, size_t count) {
+    JsonValue* array = json_create_array();
+    if (!array) return NULL;
+
+    for (size_t i = 0; i < count; i++) {
+        if (!json_array_append(array, results[i])) {
+            json_free(array);
+            for (size_t j = i; j < count; j++) json_free(results[j]);
+            return NULL;
+        }
+        results[i] = NULL;
+    }
+    return array;
+}
+
+JsonValue* json_parse_parallel(const char* buffer, size_t length, int nthreads) {
+    if (!buffer) {
+        json_set_error(JSON_ERROR_NULL_POINTER, "Input buffer is NULL", 0, 0);
+        return NULL;
+    }
+
+    if (nthreads <= 0) {
+        long cores = sysconf(_SC_NPROCESSORS_ONLN);
+        nthreads = cores > 0 ? (int)cores : 1;
+    }
+
+    const char* p = buffer;
+    const char* end = buffer + length;
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r')) p++;
+
+    ElementList list = {NULL, 0, 0};
+    bool is_array = p < end && *p == '[';
+    bool split_ok;
+
+    if (is_array) {
+        split_ok = split_array_elements(p + 1, end, &list);
+    } else {
+        split_ok = split_ndjson_records(p, end, &list);
+    }
+
+    if (!split_ok) {
+        free(list.ranges);
+        // Malformed or not splittable; let the sequential parser produce
+        // a proper error (or the result, for a single non-array value)
+        return json_parse_buffer(buffer, length);
+    }
+
+    if (is_array && (list.count < PARALLEL_MIN_ELEMENTS || nthreads == 1)) {
+        // Too small to be worth the fan-out; the whole buffer is one
+        // document, so hand it to the sequential parser directly.
+        // Newline-delimited input cannot take this shortcut and runs
+        // through the worker path with a single thread instead.
+        free(list.ranges);
+        return json_parse_buffer(buffer, length);
+    }
+
+    if (!is_array && list.count < PARALLEL_MIN_ELEMENTS) {
+        nthreads = 1;
+    }
+
+    if ((size_t)nthreads > list.count) {
+        nthreads = (int)list.count;
+    }
+
+    JsonValue** results = calloc(list.count, sizeof(JsonValue*));
+    pthread_t* threads = malloc((size_t)nthreads * sizeof(pthread_t));
+    ParallelWorker* workers = calloc((size_t)nthreads, sizeof(ParallelWorker));
+    if (!results || !threads || !workers) {
+        json_set_error(JSON_ERROR_OUT_OF_MEMORY, "Failed to allocate worker state", 0, 0);
+        free(results);
+        free(threads);
+        free(workers);
+        free(list.ranges);
+        return NULL;
+    }
+
+    size_t per_thread = (list.count + (size_t)nthreads - 1) / (size_t)nthreads;
+    int started = 0;
+    for (int i = 0; i < nthreads; i++) {
+        workers[i].ranges = list.ranges;
+        workers[i].results = results;
+        workers[i].begin = (size_t)i * per_thread;
+        workers[i].end = workers[i].begin + per_thread;
+        if (workers[i].end > list.count) workers[i].end = list.count;
+        if (workers[i].begin >= workers[i].end) break;
+
+        if (pthread_create(&threads[i], NULL, parallel_worker, &workers[i]) != 0) {
+            // Run the remaining share on this thread
+            parallel_worker(&workers[i]);
+            started = i;
+            break;
+        }
+        started = i + 1;
+    }
+
+    bool failed = false;
+    for (int i = 0; i < started; i++) {
+        pthread_join(threads[i], NULL);
+        if (workers[i].failed) failed = true;
+    }
+
+    if (failed) {
+        for (size_t i = 0; i < list.count; i++) json_free(results[i]);
+        free(results);
+        free(threads);
+        free(workers);
+        free(list.ranges);
+        // A slice failing to parse does not prove the document is invalid
+        // (e.g. one pretty-printed value was split across lines); the
+        // sequential parser decides, and produces the proper error if not
+        return json_parse_buffer(buffer, length);
+    }
+
+    JsonValue* result = stitch_results(results, list.count);
+
+    free(results);
+    free(threads);
+    free(workers);
+    free(list.ranges);
+    return result;
+}
@@ -3,6 +3,7 @@
 #include <string.h>
 #include <ctype.h>
 #include <stdio.h>
+#include <stdint.h>
 #include <math.h>
 #include <errno.h>
 
@@ -21,7 +22,9 @@
 #define unlikely(x) (x)
 #endif
 
-JsonError g_json_last_error = {JSON_ERROR_NONE, "", 0, 0, NULL};
+// One error slot per thread: workers can parse concurrently without
+// serializing behind a process-wide lock just to read diagnostics.
+_Thread_local JsonError g_json_last_error = {JSON_ERROR_NONE, "", 0, 0, NULL};
 
 const char* json_error_message(JsonErrorCode code) {
     switch (code) {
@@ -72,6 +75,25 @@ void json_set_error(JsonErrorCode code, const char* message, size_t line, size_t
     g_json_last_error.column = column;
 }
 
+#ifdef CJSON_STATS
+_Thread_local JsonStats g_json_stats;
+#endif
+
+void json_get_stats(JsonStats* out) {
+    if (!out) return;
+#ifdef CJSON_STATS
+    *out = g_json_stats;
+#else
+    memset(out, 0, sizeof(*out));
+#endif
+}
+
+void json_reset_stats(void) {
+#ifdef CJSON_STATS
+    memset(&g_json_stats, 0, sizeof(g_json_stats));
+#endif
+}
+
 typedef struct {
     const char* start;
     const char* current;
@@ -79,6 +101,8 @@ typedef struct {
     size_t line;
     size_t column;
     int depth;
+    bool insitu;
+    bool validate_only;
     Token current_token;
 } Tokenizer;
 
@@ -118,6 +142,7 @@ static const char* skip_whitespace_simd(const char* ptr, const char* end, size_t
             return ptr + non_ws_pos;
         }
         
+        JSON_STAT_ADD(whitespace_simd_chunks, 1);
         for (int i = 0; i < 16; i++) {
             if (ptr[i] == '\n') {
                 (*line)++;
@@ -142,10 +167,12 @@ static void skip_whitespace(Tokenizer* t) {
     while (t->current < t->end && *t->current) {
         char c = *t->current;
         if (c == '\n') {
+            JSON_STAT_ADD(whitespace_scalar_bytes, 1);
             t->line++;
             t->column = 0;
             t->current++;
         } else if (is_json_whitespace(c)) {
+            JSON_STAT_ADD(whitespace_scalar_bytes, 1);
             t->current++;
             t->column++;
         } else if ((unsigned char)c > 0x20 || c == 0) {
@@ -157,6 +184,60 @@ static void skip_whitespace(Tokenizer* t) {
     }
 }
 
+#if SIMD_AVAILABLE
+// Scan for the next byte a string literal cannot take verbatim:
+// '"', '\\', or a control character. Everything before it is copied wholesale.
+static const char* scan_string_sse2(const char* ptr, const char* end) {
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i ctrl_max = _mm_set1_epi8(0x1F);
+
+    while (ptr + 16 <= end) {
+        __m128i chunk = _mm_loadu_si128((const __m128i*)ptr);
+        __m128i is_quote = _mm_cmpeq_epi8(chunk, quote);
+        __m128i is_backslash = _mm_cmpeq_epi8(chunk, backslash);
+        __m128i is_ctrl = _mm_cmpeq_epi8(_mm_min_epu8(chunk, ctrl_max), chunk);
+
+        int mask = _mm_movemask_epi8(_mm_or_si128(_mm_or_si128(is_quote, is_backslash), is_ctrl));
+        if (mask != 0) {
+            return ptr + __builtin_ctz(mask);
+        }
+        ptr += 16;
+    }
+    return ptr;
+}
+
+__attribute__((target("avx2")))
+static const char* scan_string_avx2(const char* ptr, const char* end) {
+    const __m256i quote = _mm256_set1_epi8('"');
+    const __m256i backslash = _mm256_set1_epi8('\\');
+    const __m256i ctrl_max = _mm256_set1_epi8(0x1F);
+
+    while (ptr + 32 <= end) {
+        __m256i chunk = _mm256_loadu_si256((const __m256i*)ptr);
+        __m256i is_quote = _mm256_cmpeq_epi8(chunk, quote);
+        __m256i is_backslash = _mm256_cmpeq_epi8(chunk, backslash);
+        __m256i is_ctrl = _mm256_cmpeq_epi8(_mm256_min_epu8(chunk, ctrl_max), chunk);
+
+        int mask = _mm256_movemask_epi8(_mm256_or_si256(_mm256_or_si256(is_quote, is_backslash), is_ctrl));
+        if (mask != 0) {
+            return ptr + __builtin_ctz(mask);
+        }
+        ptr += 32;
+    }
+    return scan_string_sse2(ptr, end);
+}
+
+static const char* scan_string_simd(const char* ptr, const char* end) {
+    // Thread-local so concurrent parsers never race on the cached probe.
+    static _Thread_local int has_avx2 = -1;
+    if (unlikely(has_avx2 < 0)) {
+        has_avx2 = __builtin_cpu_supports("avx2");
+    }
+    return has_avx2 ? scan_string_avx2(ptr, end) : scan_string_sse2(ptr, end);
+}
+#endif
+
 static inline bool validate_number_format_strict(const char* start, const char* end) {
     if (!start || !end || start >= end) return false;
     
@@ -235,15 +316,52 @@ static char* tokenize_string(Tokenizer* t) {
     t->column++;
     
     size_t length = 0;
-    size_t capacity = 256;
-    char* result = malloc(capacity);
-    if (unlikely(!result)) {
-        json_set_error(JSON_ERROR_OUT_OF_MEMORY, "Failed to allocate string", t->line, t->column);
-        return NULL;
+    size_t capacity;
+    char* result;
+
+    if (t->insitu) {
+        // Unescaping only ever shrinks, so decode straight into the
+        // caller's buffer starting at the string's first byte
+        result = (char*)t->current;
+        capacity = (size_t)-1;
+    } else {
+        capacity = 256;
+        result = malloc(capacity);
+        if (unlikely(!result)) {
+            json_set_error(JSON_ERROR_OUT_OF_MEMORY, "Failed to allocate string", t->line, t->column);
+            return NULL;
+        }
     }
-    
+
     while (t->current < t->end && *t->current && *t->current != '"') {
-        if (unlikely(length + 6 >= capacity)) {
+#if SIMD_AVAILABLE
+        if (*t->current != '\\') {
+            const char* span_end = scan_string_simd(t->current, t->end);
+            size_t span = span_end - t->current;
+            if (span > 0) {
+                if (!t->insitu && unlikely(length + span + 6 >= capacity)) {
+                    size_t new_capacity = capacity;
+                    while (length + span + 6 >= new_capacity) new_capacity *= 2;
+                    char* new_result = realloc(result, new_capacity);
+                    if (unlikely(!new_result)) {
+                        free(result);
+                        json_set_error(JSON_ERROR_OUT_OF_MEMORY, "Failed to expand string buffer", t->line, t->column);
+                        return NULL;
+                    }
+                    result = new_result;
+                    capacity = new_capacity;
+                }
+                if (result + length != t->current) {
+                    memmove(result + length, t->current, span);
+                }
+                length += span;
+                t->current += span;
+                t->column += span;
+                continue;
+            }
+        }
+#endif
+        if (!t->insitu && unlikely(length + 6 >= capacity)) {
             size_t new_capacity = capacity * 2;
             char* new_result = realloc(result, new_capacity);
             if (unlikely(!new_result)) {
@@ -259,7 +377,7 @@ static char* tokenize_string(Tokenizer* t) {
             t->current++;
             t->column++;
             if (t->current >= t->end || !*t->current) {
-                free(result);
+                if (!t->insitu) free(result);
                 json_set_error(JSON_ERROR_UNTERMINATED_STRING, "Unterminated escape sequence", t->line, t->column);
                 return NULL;
             }
@@ -279,7 +397,7 @@ static char* tokenize_string(Tokenizer* t) {
                     unsigned int codepoint = 0;
                     for (int i = 0; i < 4; i++) {
                         if (!*t->current || !isxdigit(*t->current)) {
-                            free(result);
+                            if (!t->insitu) free(result);
                             json_set_error(JSON_ERROR_INVALID_ESCAPE, "Invalid Unicode escape", t->line, t->column);
                             return NULL;
                         }
@@ -297,7 +415,7 @@ static char* tokenize_string(Tokenizer* t) {
                             unsigned int low_surrogate = 0;
                             for (int i = 0; i < 4; i++) {
                                 if (!*t->current || !isxdigit(*t->current)) {
-                                    free(result);
+                                    if (!t->insitu) free(result);
                                     json_set_error(JSON_ERROR_INVALID_SURROGATE, "Invalid surrogate pair", t->line, t->column);
                                     return NULL;
                                 }
@@ -309,19 +427,19 @@ static char* tokenize_string(Tokenizer* t) {
                             }
                             
                             if (low_surrogate < 0xDC00 || low_surrogate > 0xDFFF) {
-                                free(result);
+                                if (!t->insitu) free(result);
                                 json_set_error(JSON_ERROR_INVALID_SURROGATE, "Invalid low surrogate", t->line, t->column);
                                 return NULL;
                             }
                             
                             codepoint = 0x10000 + ((codepoint - 0xD800) << 10) + (low_surrogate - 0xDC00);
                         } else {
-                            free(result);
+                            if (!t->insitu) free(result);
                             json_set_error(JSON_ERROR_INVALID_SURROGATE, "High surrogate without low surrogate", t->line, t->column);
                             return NULL;
                         }
                     } else if (codepoint >= 0xDC00 && codepoint <= 0xDFFF) {
-                        free(result);
+                        if (!t->insitu) free(result);
                         json_set_error(JSON_ERROR_INVALID_SURROGATE, "Unexpected low surrogate", t->line, t->column);
                         return NULL;
                     }
@@ -329,7 +447,7 @@ static char* tokenize_string(Tokenizer* t) {
                     char utf8_buffer[5];
                     int utf8_len = encode_utf8(codepoint, utf8_buffer);
                     if (utf8_len == 0) {
-                        free(result);
+                        if (!t->insitu) free(result);
                         json_set_error(JSON_ERROR_INVALID_UTF8, "Invalid codepoint", t->line, t->column);
                         return NULL;
                     }
@@ -339,14 +457,14 @@ static char* tokenize_string(Tokenizer* t) {
                     break;
                 }
                 default:
-                    free(result);
+                    if (!t->insitu) free(result);
                     json_set_error(JSON_ERROR_INVALID_ESCAPE, "Unknown escape sequence", t->line, t->column);
                     return NULL;
             }
             t->current++;
             t->column++;
         } else if ((unsigned char)*t->current < 0x20) {
-            free(result);
+            if (!t->insitu) free(result);
             json_set_error(JSON_ERROR_INVALID_SYNTAX, "Unescaped control character in string", t->line, t->column);
             return NULL;
         } else {
@@ -356,7 +474,7 @@ static char* tokenize_string(Tokenizer* t) {
     }
     
     if (*t->current != '"') {
-        free(result);
+        if (!t->insitu) free(result);
         json_set_error(JSON_ERROR_UNTERMINATED_STRING, "Expected closing '\"'", t->line, t->column);
         return NULL;
     }
@@ -367,6 +485,118 @@ static char* tokenize_string(Tokenizer* t) {
     return result;
 }
 
+// Scan-only twin of tokenize_string for validate mode: applies exactly
+// the same escape, surrogate and control-character rules but never
+// allocates or writes a byte
+static bool validate_string_scan(Tokenizer* t) {
+    if (unlikely(t->current >= t->end || *t->current != '"')) return false;
+
+    t->current++;
+    t->column++;
+
+    while (t->current < t->end && *t->current && *t->current != '"') {
+#if SIMD_AVAILABLE
+        if (*t->current != '\\') {
+            const char* span_end = scan_string_simd(t->current, t->end);
+            size_t span = span_end - t->current;
+            if (span > 0) {
+                t->current += span;
+                t->column += span;
+                continue;
+            }
+        }
+#endif
+        if (*t->current == '\\') {
+            t->current++;
+            t->column++;
+            if (t->current >= t->end || !*t->current) {
+                json_set_error(JSON_ERROR_UNTERMINATED_STRING, "Unterminated escape sequence", t->line, t->column);
+                return false;
+            }
+
+            switch (*t->current) {
+                case 'n': case 't': case 'r': case 'b':
+                case 'f': case '"': case '\\': case '/':
+                    break;
+                case 'u': {
+                    t->current++;
+                    t->column++;
+                    unsigned int codepoint = 0;
+                    for (int i = 0; i < 4; i++) {
+                        if (!*t->current || !isxdigit(*t->current)) {
+                            json_set_error(JSON_ERROR_INVALID_ESCAPE, "Invalid Unicode escape", t->line, t->column);
+                            return false;
+                        }
+                        codepoint = (codepoint << 4) | parse_hex_digit(*t->current);
+                        if (i < 3) {
+                            t->current++;
+                            t->column++;
+                        }
+                    }
+
+                    if (codepoint >= 0xD800 && codepoint <= 0xDBFF) {
+                        if (t->current[1] == '\\' && t->current[2] == 'u') {
+                            t->current += 3;
+                            t->column += 3;
+                            unsigned int low_surrogate = 0;
+                            for (int i = 0; i < 4; i++) {
+                                if (!*t->current || !isxdigit(*t->current)) {
+                                    json_set_error(JSON_ERROR_INVALID_SURROGATE, "Invalid surrogate pair", t->line, t->column);
+                                    return false;
+                                }
+                                low_surrogate = (low_surrogate << 4) | parse_hex_digit(*t->current);
+                                if (i < 3) {
+                                    t->current++;
+                                    t->column++;
+                                }
+                            }
+
+                            if (low_surrogate < 0xDC00 || low_surrogate > 0xDFFF) {
+                                json_set_error(JSON_ERROR_INVALID_SURROGATE, "Invalid low surrogate", t->line, t->column);
+                                return false;
+                            }
+
+                            codepoint = 0x10000 + ((codepoint - 0xD800) << 10) + (low_surrogate - 0xDC00);
+                        } else {
+                            json_set_error(JSON_ERROR_INVALID_SURROGATE, "High surrogate without low surrogate", t->line, t->column);
+                            return false;
+                        }
+                    } else if (codepoint >= 0xDC00 && codepoint <= 0xDFFF) {
+                        json_set_error(JSON_ERROR_INVALID_SURROGATE, "Unexpected low surrogate", t->line, t->column);
+                        return false;
+                    }
+
+                    char utf8_buffer[5];
+                    if (encode_utf8(codepoint, utf8_buffer) == 0) {
+                        json_set_error(JSON_ERROR_INVALID_UTF8, "Invalid codepoint", t->line, t->column);
+                        return false;
+                    }
+                    break;
+                }
+                default:
+                    json_set_error(JSON_ERROR_INVALID_ESCAPE, "Unknown escape sequence", t->line, t->column);
+                    return false;
+            }
+            t->current++;
+            t->column++;
+        } else if ((unsigned char)*t->current < 0x20) {
+            json_set_error(JSON_ERROR_INVALID_SYNTAX, "Unescaped control character in string", t->line, t->column);
+            return false;
+        } else {
+            t->current++;
+            t->column++;
+        }
+    }
+
+    if (*t->current != '"') {
+        json_set_error(JSON_ERROR_UNTERMINATED_STRING, "Expected closing '\"'", t->line, t->column);
+        return false;
+    }
+    t->current++;
+    t->column++;
+    return true;
+}
+
 static Token next_token(Tokenizer* t) {
     Token token = {TOKEN_ERROR, t->current, 0, t->line, t->column, {0}};
     
@@ -446,6 +676,14 @@ static Token next_token(Tokenizer* t) {
             }
             break;
         case '"': {
+            if (t->validate_only) {
+                if (validate_string_scan(t)) {
+                    token.type = TOKEN_STRING;
+                    token.value.string = NULL;
+                    token.length = t->current - token.start;
+                }
+                return token;
+            }
             char* str = tokenize_string(t);
             if (str) {
                 token.type = TOKEN_STRING;
@@ -512,15 +750,12 @@ static Token next_token(Tokenizer* t) {
                 return token;
             }
             
-            errno = 0;
-            char* end;
-            double value = strtod(start, &end);
-            
-            if (errno == ERANGE) {
+            double value;
+            if (!json_number_parse(start, p, &value)) {
                 json_set_error(JSON_ERROR_NUMBER_OUT_OF_RANGE, "Number out of range", t->line, t->column);
                 return token;
             }
-            
+
             if (isinf(value) || isnan(value)) {
                 json_set_error(JSON_ERROR_NUMBER_OUT_OF_RANGE, "Number is infinity or NaN", t->line, t->column);
                 return token;
@@ -540,221 +775,274 @@ static Token next_token(Tokenizer* t) {
 }
 
 static JsonValue* parse_value(Tokenizer* t);
+static JsonValue* create_string_view(char* str);
+static bool object_set_internal(JsonValue* object, char* key, JsonValue* value, bool copy_key);
+
+// Free the payload of a token that was fetched but won't be consumed
+// (grammar error paths); only string tokens own memory
+static void discard_token(Tokenizer* t, Token* token) {
+    if (token->type == TOKEN_STRING && !t->insitu && !t->validate_only) {
+        free(token->value.string);
+        token->value.string = NULL;
+    }
+}
 
 #define MAX_NESTING_DEPTH 1000
 
-static JsonValue* parse_array(Tokenizer* t) {
-    if (unlikely(++t->depth > MAX_NESTING_DEPTH)) {
-        json_set_error(JSON_ERROR_STACK_OVERFLOW, "Nesting too deep", t->line, t->column);
-        t->depth--;
-        return NULL;
-    }
-    
-    JsonValue* array = json_create_array();
-    if (unlikely(!array)) {
-        t->depth--;
-        return NULL;
-    }
-    
-    t->current_token = next_token(t);
-    
-    if (t->current_token.type == TOKEN_RBRACKET) {
-        t->depth--;
-        return array;
-    }
-    
-    while (true) {
-        JsonValue* value = parse_value(t);
-        if (unlikely(!value)) {
-            json_free(array);
-            t->depth--;
-            return NULL;
-        }
-        
-        if (unlikely(!json_array_append(array, value))) {
-            json_free(value);
-            json_free(array);
-            t->depth--;
-            return NULL;
-        }
-        
-        t->current_token = next_token(t);
-        
-        if (t->current_token.type == TOKEN_COMMA) {
-            t->current_token = next_token(t);
-        } else if (likely(t->current_token.type == TOKEN_RBRACKET)) {
-            break;
-        } else {
-            json_free(array);
-            json_set_error(JSON_ERROR_UNEXPECTED_TOKEN, "Expected ',' or ']'", t->current_token.line, t->current_token.column);
-            t->depth--;
-            return NULL;
-        }
-    }
-    
-    t->depth--;
-    return array;
+// Nesting depth is a per-thread memory knob, not a C-stack limit: the
+// parser, validator, free, deep copy and equals all keep their traversal
+// state on heap-backed stacks. Passing 0 restores the default.
+static _Thread_local size_t g_max_nesting_depth = MAX_NESTING_DEPTH;
+
+void json_set_max_depth(size_t depth) {
+    g_max_nesting_depth = depth ? depth : MAX_NESTING_DEPTH;
 }
 
-static JsonValue* parse_object(Tokenizer* t) {
-    if (unlikely(++t->depth > MAX_NESTING_DEPTH)) {
-        json_set_error(JSON_ERROR_STACK_OVERFLOW, "Nesting too deep", t->line, t->column);
-        t->depth--;
-        return NULL;
-    }
-    
-    JsonValue* object = json_create_object();
-    if (unlikely(!object)) {
-        t->depth--;
-        return NULL;
-    }
-    
-    t->current_token = next_token(t);
-    
-    if (t->current_token.type == TOKEN_RBRACE) {
-        t->depth--;
-        return object;
-    }
-    
-    while (true) {
-        if (unlikely(t->current_token.type != TOKEN_STRING)) {
-            json_free(object);
-            json_set_error(JSON_ERROR_UNEXPECTED_TOKEN, "Expected string key", t->current_token.line, t->current_token.column);
-            t->depth--;
-            return NULL;
-        }
-        
-        char* key = t->current_token.value.string;
-        
-        t->current_token = next_token(t);
-        if (unlikely(t->current_token.type != TOKEN_COLON)) {
-            free(key);
-            json_free(object);
-            json_set_error(JSON_ERROR_UNEXPECTED_TOKEN, "Expected ':'", t->current_token.line, t->current_token.column);
-            t->depth--;
-            return NULL;
-        }
-        
-        t->current_token = next_token(t);
-        JsonValue* value = parse_value(t);
-        if (unlikely(!value)) {
-            free(key);
-            json_free(object);
-            t->depth--;
-            return NULL;
-        }
-        
-        if (unlikely(!json_object_set(object, key, value))) {
-            free(key);
-            json_free(value);
-            json_free(object);
-            t->depth--;
-            return NULL;
-        }
-        free(key);
-        
-        t->current_token = next_token(t);
-        
-        if (t->current_token.type == TOKEN_COMMA) {
-            t->current_token = next_token(t);
-        } else if (likely(t->current_token.type == TOKEN_RBRACE)) {
-            break;
-        } else {
-            json_free(object);
-            json_set_error(JSON_ERROR_UNEXPECTED_TOKEN, "Expected ',' or '}'", t->current_token.line, t->current_token.column);
-            t->depth--;
-            return NULL;
-        }
-    }
-    
-    t->depth--;
-    return object;
+size_t json_get_max_depth(void) {
+    return g_max_nesting_depth;
 }
 
+#define PARSE_STACK_INITIAL 64
+
+// One frame per open container; pending_key is the object key (owned
+// unless insitu) waiting for its value
+typedef struct {
+    JsonValue* container;
+    char* pending_key;
+} ParseFrame;
+
 static JsonValue* parse_value(Tokenizer* t) {
+    ParseFrame* frames = NULL;
+    size_t depth = 0;
+    size_t frame_capacity = 0;
+    JsonValue* current = NULL;
+
+value_start:
     switch (t->current_token.type) {
         case TOKEN_NULL:
-            return json_create_null();
+            current = json_create_null();
+            break;
         case TOKEN_TRUE:
-            return json_create_bool(true);
+            current = json_create_bool(true);
+            break;
         case TOKEN_FALSE:
-            return json_create_bool(false);
+            current = json_create_bool(false);
+            break;
         case TOKEN_NUMBER:
-            return json_create_number(t->current_token.value.number);
-        case TOKEN_STRING: {
-            JsonValue* val = json_create_string(t->current_token.value.string);
-            free(t->current_token.value.string);
-            return val;
-        }
+            current = json_create_number(t->current_token.value.number);
+            break;
+        case TOKEN_STRING:
+            if (t->insitu) {
+                current = create_string_view(t->current_token.value.string);
+            } else {
+                current = json_create_string(t->current_token.value.string);
+                free(t->current_token.value.string);
+            }
+            break;
         case TOKEN_LBRACKET:
-            return parse_array(t);
-        case TOKEN_LBRACE:
-            return parse_object(t);
+        case TOKEN_LBRACE: {
+            bool is_object = t->current_token.type == TOKEN_LBRACE;
+            if (unlikely(depth >= g_max_nesting_depth)) {
+                json_set_error(JSON_ERROR_STACK_OVERFLOW, "Nesting too deep", t->line, t->column);
+                goto fail;
+            }
+            if (depth >= frame_capacity) {
+                size_t new_capacity = frame_capacity == 0 ? PARSE_STACK_INITIAL : frame_capacity * 2;
+                ParseFrame* grown = realloc(frames, new_capacity * sizeof(ParseFrame));
+                if (unlikely(!grown)) {
+                    json_set_error(JSON_ERROR_OUT_OF_MEMORY, "Failed to grow parse stack", 0, 0);
+                    goto fail;
+                }
+                frames = grown;
+                frame_capacity = new_capacity;
+            }
+            JsonValue* container = is_object ? json_create_object() : json_create_array();
+            if (unlikely(!container)) goto fail;
+            frames[depth].container = container;
+            frames[depth].pending_key = NULL;
+            depth++;
+
+            t->current_token = next_token(t);
+            if (is_object) {
+                if (t->current_token.type == TOKEN_RBRACE) {
+                    current = frames[--depth].container;
+                    break;
+                }
+                goto key_start;
+            }
+            if (t->current_token.type == TOKEN_RBRACKET) {
+                current = frames[--depth].container;
+                break;
+            }
+            goto value_start;
+        }
         case TOKEN_EOF:
             json_set_error(JSON_ERROR_UNEXPECTED_EOF, "Unexpected end of input", t->line, t->column);
-            return NULL;
+            goto fail;
         default:
             json_set_error(JSON_ERROR_UNEXPECTED_TOKEN, "Unexpected token", t->current_token.line, t->current_token.column);
-            return NULL;
+            goto fail;
     }
-}
+    if (unlikely(!current)) goto fail;
 
-JsonValue* json_parse_with_error(const char* json_string, JsonError* error) {
-    json_clear_error();
-    
-    if (!json_string) {
-        json_set_error(JSON_ERROR_NULL_POINTER, "Input string is NULL", 0, 0);
-        if (error) *error = g_json_last_error;
-        return NULL;
+value_done:
+    if (depth == 0) {
+        free(frames);
+        return current;
+    }
+    {
+        ParseFrame* top = &frames[depth - 1];
+        if (top->container->type == JSON_ARRAY) {
+            if (unlikely(!json_array_append(top->container, current))) {
+                json_free(current);
+                goto fail;
+            }
+            t->current_token = next_token(t);
+            if (t->current_token.type == TOKEN_COMMA) {
+                t->current_token = next_token(t);
+                goto value_start;
+            }
+            if (likely(t->current_token.type == TOKEN_RBRACKET)) {
+                current = frames[--depth].container;
+                goto value_done;
+            }
+            discard_token(t, &t->current_token);
+            json_set_error(JSON_ERROR_UNEXPECTED_TOKEN, "Expected ',' or ']'", t->current_token.line, t->current_token.column);
+            goto fail;
+        }
+
+        if (unlikely(!object_set_internal(top->container, top->pending_key, current, !t->insitu))) {
+            json_free(current);
+            goto fail;
+        }
+        if (!t->insitu) free(top->pending_key);
+        top->pending_key = NULL;
+
+        t->current_token = next_token(t);
+        if (t->current_token.type == TOKEN_COMMA) {
+            t->current_token = next_token(t);
+            goto key_start;
+        }
+        if (likely(t->current_token.type == TOKEN_RBRACE)) {
+            current = frames[--depth].container;
+            goto value_done;
+        }
+        discard_token(t, &t->current_token);
+        json_set_error(JSON_ERROR_UNEXPECTED_TOKEN, "Expected ',' or '}'", t->current_token.line, t->current_token.column);
+        goto fail;
     }
-    
-    size_t input_length = strlen(json_string);
+
+key_start:
+    if (unlikely(t->current_token.type != TOKEN_STRING)) {
+        json_set_error(JSON_ERROR_UNEXPECTED_TOKEN, "Expected string key", t->current_token.line, t->current_token.column);
+        goto fail;
+    }
+    frames[depth - 1].pending_key = t->current_token.value.string;
+
+    t->current_token = next_token(t);
+    if (unlikely(t->current_token.type != TOKEN_COLON)) {
+        discard_token(t, &t->current_token);
+        json_set_error(JSON_ERROR_UNEXPECTED_TOKEN, "Expected ':'", t->current_token.line, t->current_token.column);
+        goto fail;
+    }
+    t->current_token = next_token(t);
+    goto value_start;
+
+fail:
+    // Open containers are attached to their parents only on completion, so
+    // each frame owns its container (with any completed children) separately
+    for (size_t i = depth; i > 0; i--) {
+        if (frames[i - 1].pending_key && !t->insitu) {
+            free(frames[i - 1].pending_key);
+        }
+        json_free(frames[i - 1].container);
+    }
+    free(frames);
+    return NULL;
+}
+
+static JsonValue* parse_run(const char* buffer, size_t length, bool insitu, JsonError* error) {
+    json_clear_error();
+
+    if (!buffer) {
+        json_set_error(JSON_ERROR_NULL_POINTER, "Input string is NULL", 0, 0);
+        if (error) *error = g_json_last_error;
+        return NULL;
+    }
+
     Tokenizer tokenizer = {
-        json_string, 
-        json_string, 
-        json_string + input_length,
-        1, 
-        0, 
-        0, 
+        buffer,
+        buffer,
+        buffer + length,
+        1,
+        0,
+        0,
+        insitu,
+        false,
         {TOKEN_ERROR, NULL, 0, 0, 0, {0}}
     };
     tokenizer.current_token = next_token(&tokenizer);
-    
+
     JsonValue* result = parse_value(&tokenizer);
-    
+
     if (result) {
         Token next = next_token(&tokenizer);
         if (next.type != TOKEN_EOF) {
+            discard_token(&tokenizer, &next);
             json_free(result);
             json_set_error(JSON_ERROR_UNEXPECTED_TOKEN, "Extra data after JSON value", next.line, next.column);
             result = NULL;
         }
     }
-    
+
+    JSON_STAT_ADD(bytes_tokenized, (size_t)(tokenizer.current - buffer));
+
     if (error) *error = g_json_last_error;
     return result;
 }
 
+JsonValue* json_parse_with_error(const char* json_string, JsonError* error) {
+    return parse_run(json_string, json_string ? strlen(json_string) : 0, false, error);
+}
+
 JsonValue* json_parse(const char* json_string) {
     return json_parse_with_error(json_string, NULL);
 }
 
-JsonValue* json_create_null(void) {
-    JsonValue* value = malloc(sizeof(JsonValue));
+JsonValue* json_parse_buffer(const char* buffer, size_t length) {
+    return parse_run(buffer, length, false, NULL);
+}
+
+JsonValue* json_parse_insitu_with_error(char* buffer, JsonError* error) {
+    return parse_run(buffer, buffer ? strlen(buffer) : 0, true, error);
+}
+
+JsonValue* json_parse_insitu(char* buffer) {
+    return json_parse_insitu_with_error(buffer, NULL);
+}
+
+static JsonValue* alloc_value(void) {
+    JsonArena* arena = json_arena_active();
+    JsonValue* value = arena ? json_arena_alloc(arena, sizeof(JsonValue)) : malloc(sizeof(JsonValue));
     if (!value) {
         json_set_error(JSON_ERROR_OUT_OF_MEMORY, "Failed to allocate JsonValue", 0, 0);
         return NULL;
     }
+    value->flags = arena ? JSON_VALUE_FLAG_ARENA : 0;
+    JSON_STAT_ADD(values_allocated, 1);
+    return value;
+}
+
+JsonValue* json_create_null(void) {
+    JsonValue* value = alloc_value();
+    if (!value) return NULL;
     value->type = JSON_NULL;
     return value;
 }
 
 JsonValue* json_create_bool(bool val) {
-    JsonValue* value = malloc(sizeof(JsonValue));
-    if (!value) {
-        json_set_error(JSON_ERROR_OUT_OF_MEMORY, "Failed to allocate JsonValue", 0, 0);
-        return NULL;
-    }
+    JsonValue* value = alloc_value();
+    if (!value) return NULL;
     value->type = JSON_BOOL;
     value->data.bool_value = val;
     return value;
@@ -765,70 +1053,91 @@ JsonValue* json_create_number(double val) {
         json_set_error(JSON_ERROR_INVALID_NUMBER, "Number is NaN or Infinity", 0, 0);
         return NULL;
     }
-    
-    JsonValue* value = malloc(sizeof(JsonValue));
-    if (!value) {
-        json_set_error(JSON_ERROR_OUT_OF_MEMORY, "Failed to allocate JsonValue", 0, 0);
-        return NULL;
-    }
+
+    JsonValue* value = alloc_value();
+    if (!value) return NULL;
     value->type = JSON_NUMBER;
     value->data.number_value = val;
     return value;
 }
 
+// In-situ strings point into the caller's buffer; json_free must not touch them
+static JsonValue* create_string_view(char* str) {
+    JsonValue* value = alloc_value();
+    if (!value) return NULL;
+    value->type = JSON_STRING;
+    value->flags |= JSON_VALUE_FLAG_STRING_VIEW;
+    value->data.string_value = str;
+    return value;
+}
+
 JsonValue* json_create_string(const char* val) {
     if (!val) {
         json_set_error(JSON_ERROR_NULL_POINTER, "String value is NULL", 0, 0);
         return NULL;
     }
-    
-    JsonValue* value = malloc(sizeof(JsonValue));
-    if (!value) {
-        json_set_error(JSON_ERROR_OUT_OF_MEMORY, "Failed to allocate JsonValue", 0, 0);
-        return NULL;
-    }
-    
+
+    JsonValue* value = alloc_value();
+    if (!value) return NULL;
+
     value->type = JSON_STRING;
-    value->data.string_value = strdup(val);
+
+    size_t len = strlen(val);
+    if (len <= JSON_INLINE_STRING_MAX) {
+        memcpy(value->data.inline_string, val, len + 1);
+        value->flags |= JSON_VALUE_FLAG_INLINE_STRING;
+        return value;
+    }
+
+    value->data.string_value = json_arena_strdup(json_arena_active(), val);
     if (!value->data.string_value) {
-        free(value);
+        if (!(value->flags & JSON_VALUE_FLAG_ARENA)) free(value);
         json_set_error(JSON_ERROR_OUT_OF_MEMORY, "Failed to allocate string", 0, 0);
         return NULL;
     }
     return value;
 }
 
+// The one supported way to read string contents: resolves inline
+// storage, views and heap strings alike.
+const char* json_string_value(const JsonValue* value) {
+    if (!value || value->type != JSON_STRING) return NULL;
+    return (value->flags & JSON_VALUE_FLAG_INLINE_STRING)
+               ? value->data.inline_string
+               : value->data.string_value;
+}
+
 JsonValue* json_create_array(void) {
-    JsonValue* value = malloc(sizeof(JsonValue));
-    if (!value) {
-        json_set_error(JSON_ERROR_OUT_OF_MEMORY, "Failed to allocate JsonValue", 0, 0);
-        return NULL;
-    }
-    
+    JsonArena* arena = json_arena_active();
+    JsonValue* value = alloc_value();
+    if (!value) return NULL;
+
     value->type = JSON_ARRAY;
-    value->data.array_value = calloc(1, sizeof(JsonArray));
+    value->data.array_value = arena ? json_arena_alloc(arena, sizeof(JsonArray)) : calloc(1, sizeof(JsonArray));
     if (!value->data.array_value) {
-        free(value);
+        if (!arena) free(value);
         json_set_error(JSON_ERROR_OUT_OF_MEMORY, "Failed to allocate JsonArray", 0, 0);
         return NULL;
     }
+    if (arena) memset(value->data.array_value, 0, sizeof(JsonArray));
+    value->data.array_value->arena = arena;
     return value;
 }
 
 JsonValue* json_create_object(void) {
-    JsonValue* value = malloc(sizeof(JsonValue));
-    if (!value) {
-        json_set_error(JSON_ERROR_OUT_OF_MEMORY, "Failed to allocate JsonValue", 0, 0);
-        return NULL;
-    }
-    
+    JsonArena* arena = json_arena_active();
+    JsonValue* value = alloc_value();
+    if (!value) return NULL;
+
     value->type = JSON_OBJECT;
-    value->data.object_value = calloc(1, sizeof(JsonObject));
+    value->data.object_value = arena ? json_arena_alloc(arena, sizeof(JsonObject)) : calloc(1, sizeof(JsonObject));
     if (!value->data.object_value) {
-        free(value);
+        if (!arena) free(value);
         json_set_error(JSON_ERROR_OUT_OF_MEMORY, "Failed to allocate JsonObject", 0, 0);
         return NULL;
     }
+    if (arena) memset(value->data.object_value, 0, sizeof(JsonObject));
+    value->data.object_value->arena = arena;
     return value;
 }
 
@@ -846,7 +1155,9 @@ bool json_array_append(JsonValue* array, JsonValue* value) {
     JsonArray* arr = array->data.array_value;
     if (arr->count >= arr->capacity) {
         size_t new_capacity = arr->capacity == 0 ? 16 : arr->capacity * 2;
-        JsonValue** new_values = realloc(arr->values, new_capacity * sizeof(JsonValue*));
+        JsonValue** new_values = json_arena_grow(arr->arena, arr->values,
+                                                 arr->capacity * sizeof(JsonValue*),
+                                                 new_capacity * sizeof(JsonValue*));
         if (!new_values) {
             json_set_error(JSON_ERROR_OUT_OF_MEMORY, "Failed to expand array", 0, 0);
             return false;
@@ -858,30 +1169,128 @@ bool json_array_append(JsonValue* array, JsonValue* value) {
     return true;
 }
 
-bool json_object_set(JsonValue* object, const char* key, JsonValue* value) {
+// Objects past this size get an open-addressing hash table over pairs[],
+// built lazily so small objects pay nothing
+#define OBJECT_HASH_THRESHOLD 32
+
+static inline uint64_t hash_object_key(const char* key) {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    while (*key) {
+        hash ^= (unsigned char)*key++;
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+static void object_index_release(JsonObject* obj) {
+    if (!obj->arena) free(obj->hash_index);
+    obj->hash_index = NULL;
+    obj->index_capacity = 0;
+}
+
+static void object_index_insert(JsonObject* obj, const char* key, size_t pair_index) {
+    size_t mask = obj->index_capacity - 1;
+    size_t slot = hash_object_key(key) & mask;
+    while (obj->hash_index[slot] != 0) {
+        slot = (slot + 1) & mask;
+    }
+    obj->hash_index[slot] = pair_index + 1;
+}
+
+static bool object_build_index(JsonObject* obj) {
+    size_t capacity = 16;
+    while (capacity < obj->count * 2) capacity <<= 1;
+
+    size_t* index = obj->arena ? json_arena_alloc(obj->arena, capacity * sizeof(size_t))
+                               : malloc(capacity * sizeof(size_t));
+    if (!index) return false;
+    memset(index, 0, capacity * sizeof(size_t));
+
+    if (!obj->arena) free(obj->hash_index);
+    obj->hash_index = index;
+    obj->index_capacity = capacity;
+
+    for (size_t i = 0; i < obj->count; i++) {
+        object_index_insert(obj, obj->pairs[i].key, i);
+    }
+    return true;
+}
+
+static size_t object_find_pair(JsonObject* obj, const char* key) {
+    JSON_STAT_ADD(object_lookups, 1);
+
+    if (!obj->hash_index && !obj->sorted && obj->count >= OBJECT_HASH_THRESHOLD) {
+        object_build_index(obj);
+    }
+
+    if (obj->hash_index) {
+        size_t mask = obj->index_capacity - 1;
+        size_t slot = hash_object_key(key) & mask;
+        while (obj->hash_index[slot] != 0) {
+            JSON_STAT_ADD(object_scan_steps, 1);
+            size_t pair_index = obj->hash_index[slot] - 1;
+            const char* obj_key = obj->pairs[pair_index].key;
+            if (obj_key == key || strcmp(obj_key, key) == 0) {
+                return pair_index;
+            }
+            slot = (slot + 1) & mask;
+        }
+        return (size_t)-1;
+    }
+
+    if (obj->sorted) {
+        size_t lo = 0;
+        size_t hi = obj->count;
+        while (lo < hi) {
+            JSON_STAT_ADD(object_scan_steps, 1);
+            size_t mid = lo + (hi - lo) / 2;
+            int cmp = strcmp(obj->pairs[mid].key, key);
+            if (cmp == 0) return mid;
+            if (cmp < 0) lo = mid + 1;
+            else hi = mid;
+        }
+        return (size_t)-1;
+    }
+
+    size_t key_len = strlen(key);
+    for (size_t i = 0; i < obj->count; i++) {
+        JSON_STAT_ADD(object_scan_steps, 1);
+        const char* obj_key = obj->pairs[i].key;
+        if (obj_key == key) return i;  // interned keys share one allocation
+        if (likely(obj_key[0] == key[0])) {
+            if (strlen(obj_key) == key_len && memcmp(obj_key, key, key_len) == 0) {
+                return i;
+            }
+        }
+    }
+    return (size_t)-1;
+}
+
+static bool object_set_internal(JsonValue* object, char* key, JsonValue* value, bool copy_key) {
     if (!object || !key || !value) {
         json_set_error(JSON_ERROR_NULL_POINTER, "Object, key or value is NULL", 0, 0);
         return false;
     }
-    
+
     if (object->type != JSON_OBJECT) {
         json_set_error(JSON_ERROR_INVALID_TYPE, "Not an object", 0, 0);
         return false;
     }
-    
+
     JsonObject* obj = object->data.object_value;
-    
-    for (size_t i = 0; i < obj->count; i++) {
-        if (strcmp(obj->pairs[i].key, key) == 0) {
-            json_free(obj->pairs[i].value);
-            obj->pairs[i].value = value;
-            return true;
-        }
+
+    size_t existing = object_find_pair(obj, key);
+    if (existing != (size_t)-1) {
+        json_free(obj->pairs[existing].value);
+        obj->pairs[existing].value = value;
+        return true;
     }
-    
+
     if (obj->count >= obj->capacity) {
         size_t new_capacity = obj->capacity == 0 ? 16 : obj->capacity * 2;
-        JsonPair* new_pairs = realloc(obj->pairs, new_capacity * sizeof(JsonPair));
+        JsonPair* new_pairs = json_arena_grow(obj->arena, obj->pairs,
+                                             obj->capacity * sizeof(JsonPair),
+                                             new_capacity * sizeof(JsonPair));
         if (!new_pairs) {
             json_set_error(JSON_ERROR_OUT_OF_MEMORY, "Failed to expand object", 0, 0);
             return false;
@@ -889,14 +1298,116 @@ bool json_object_set(JsonValue* object, const char* key, JsonValue* value) {
         obj->pairs = new_pairs;
         obj->capacity = new_capacity;
     }
-    
-    obj->pairs[obj->count].key = strdup(key);
-    if (!obj->pairs[obj->count].key) {
-        json_set_error(JSON_ERROR_OUT_OF_MEMORY, "Failed to allocate key", 0, 0);
-        return false;
+
+    if (copy_key) {
+        // Interning dedupes repeated keys when the arena has it enabled;
+        // otherwise this is a plain arena/heap strdup
+        obj->pairs[obj->count].key = (char*)json_arena_intern(obj->arena, key);
+        if (!obj->pairs[obj->count].key) {
+            json_set_error(JSON_ERROR_OUT_OF_MEMORY, "Failed to allocate key", 0, 0);
+            return false;
+        }
+        obj->pairs[obj->count].flags = 0;
+    } else {
+        obj->pairs[obj->count].key = key;
+        obj->pairs[obj->count].flags = JSON_PAIR_KEY_BORROWED;
     }
     obj->pairs[obj->count].value = value;
     obj->count++;
+    obj->sorted = false;
+
+    if (obj->hash_index) {
+        if (obj->count * 2 > obj->index_capacity) {
+            object_build_index(obj);
+        } else {
+            object_index_insert(obj, obj->pairs[obj->count - 1].key, obj->count - 1);
+        }
+    }
+    return true;
+}
+
+bool json_object_set(JsonValue* object, const char* key, JsonValue* value) {
+    return object_set_internal(object, (char*)key, value, true);
+}
+
+// Bulk insert for build-once objects: capacity is reserved up front and the
+// per-insert duplicate scan is skipped, so keys must be distinct and not
+// already present. Values are owned by the object on success.
+bool json_object_set_many(JsonValue* object, const char** keys, JsonValue** values, size_t count) {
+    if (!object || !keys || !values) {
+        json_set_error(JSON_ERROR_NULL_POINTER, "Object, keys or values is NULL", 0, 0);
+        return false;
+    }
+
+    if (object->type != JSON_OBJECT) {
+        json_set_error(JSON_ERROR_INVALID_TYPE, "Not an object", 0, 0);
+        return false;
+    }
+
+    if (count == 0) return true;
+
+    JsonObject* obj = object->data.object_value;
+
+    if (obj->count + count > obj->capacity) {
+        size_t new_capacity = obj->capacity == 0 ? 16 : obj->capacity;
+        while (new_capacity < obj->count + count) new_capacity *= 2;
+        JsonPair* new_pairs = json_arena_grow(obj->arena, obj->pairs,
+                                             obj->capacity * sizeof(JsonPair),
+                                             new_capacity * sizeof(JsonPair));
+        if (!new_pairs) {
+            json_set_error(JSON_ERROR_OUT_OF_MEMORY, "Failed to expand object", 0, 0);
+            return false;
+        }
+        obj->pairs = new_pairs;
+        obj->capacity = new_capacity;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        if (!keys[i] || !values[i]) {
+            json_set_error(JSON_ERROR_NULL_POINTER, "Key or value is NULL", 0, 0);
+            return false;
+        }
+        obj->pairs[obj->count].key = (char*)json_arena_intern(obj->arena, keys[i]);
+        if (!obj->pairs[obj->count].key) {
+            json_set_error(JSON_ERROR_OUT_OF_MEMORY, "Failed to allocate key", 0, 0);
+            return false;
+        }
+        obj->pairs[obj->count].flags = 0;
+        obj->pairs[obj->count].value = values[i];
+        obj->count++;
+    }
+    obj->sorted = false;
+
+    if (obj->hash_index) {
+        object_build_index(obj);
+    }
+    return true;
+}
+
+static int compare_pairs_by_key(const void* a, const void* b) {
+    return strcmp(((const JsonPair*)a)->key, ((const JsonPair*)b)->key);
+}
+
+// Sort pairs by key and switch lookups to binary search — worthwhile for
+// objects built once and queried many times. The lazy hash index is dropped;
+// inserting a new key afterwards clears the flag again.
+bool json_object_sort_keys(JsonValue* object) {
+    if (!object) {
+        json_set_error(JSON_ERROR_NULL_POINTER, "Object is NULL", 0, 0);
+        return false;
+    }
+
+    if (object->type != JSON_OBJECT) {
+        json_set_error(JSON_ERROR_INVALID_TYPE, "Not an object", 0, 0);
+        return false;
+    }
+
+    JsonObject* obj = object->data.object_value;
+    if (obj->count > 1) {
+        qsort(obj->pairs, obj->count, sizeof(JsonPair), compare_pairs_by_key);
+    }
+    obj->sorted = true;
+    object_index_release(obj);
     return true;
 }
 
@@ -905,25 +1416,18 @@ JsonValue* json_object_get(const JsonValue* object, const char* key) {
         json_set_error(JSON_ERROR_NULL_POINTER, "Object or key is NULL", 0, 0);
         return NULL;
     }
-    
+
     if (unlikely(object->type != JSON_OBJECT)) {
         json_set_error(JSON_ERROR_INVALID_TYPE, "Not an object", 0, 0);
         return NULL;
     }
-    
+
     JsonObject* obj = object->data.object_value;
-    size_t key_len = strlen(key);
-    
-    for (size_t i = 0; i < obj->count; i++) {
-        const char* obj_key = obj->pairs[i].key;
-        if (likely(obj_key[0] == key[0])) {
-            size_t obj_key_len = strlen(obj_key);
-            if (obj_key_len == key_len && memcmp(obj_key, key, key_len) == 0) {
-                return obj->pairs[i].value;
-            }
-        }
+    size_t index = object_find_pair(obj, key);
+    if (index != (size_t)-1) {
+        return obj->pairs[index].value;
     }
-    
+
     json_set_error(JSON_ERROR_KEY_NOT_FOUND, key, 0, 0);
     return NULL;
 }
@@ -966,47 +1470,89 @@ size_t json_object_size(const JsonValue* object) {
 
 bool json_object_has(const JsonValue* object, const char* key) {
     if (!object || object->type != JSON_OBJECT || !key) return false;
-    JsonObject* obj = object->data.object_value;
-    size_t key_len = strlen(key);
-    for (size_t i = 0; i < obj->count; i++) {
-        const char* obj_key = obj->pairs[i].key;
-        if (obj_key[0] == key[0] && strlen(obj_key) == key_len && strcmp(obj_key, key) == 0) {
-            return true;
-        }
-    }
-    return false;
+    return object_find_pair(object->data.object_value, key) != (size_t)-1;
 }
 
+// Iterative: container children go onto a heap-backed stack instead of the
+// C stack, so arbitrarily deep trees free without recursion. If the stack
+// cannot grow, the child is freed recursively as a fallback.
 void json_free(JsonValue* value) {
     if (!value) return;
-    
-    switch (value->type) {
-        case JSON_STRING:
-            free(value->data.string_value);
-            break;
-        case JSON_ARRAY: {
-            JsonArray* arr = value->data.array_value;
-            for (size_t i = 0; i < arr->count; i++) {
-                json_free(arr->values[i]);
+
+    JsonValue** stack = NULL;
+    size_t count = 0;
+    size_t capacity = 0;
+
+    for (;;) {
+        switch (value->type) {
+            case JSON_STRING:
+                if (!(value->flags & (JSON_VALUE_FLAG_ARENA | JSON_VALUE_FLAG_STRING_VIEW |
+                                      JSON_VALUE_FLAG_INLINE_STRING))) {
+                    free(value->data.string_value);
+                }
+                break;
+            case JSON_ARRAY: {
+                JsonArray* arr = value->data.array_value;
+                for (size_t i = 0; i < arr->count; i++) {
+                    if (count >= capacity) {
+                        size_t new_capacity = capacity == 0 ? PARSE_STACK_INITIAL : capacity * 2;
+                        JsonValue** grown = realloc(stack, new_capacity * sizeof(JsonValue*));
+                        if (!grown) {
+                            json_free(arr->values[i]);
+                            continue;
+                        }
+                        stack = grown;
+                        capacity = new_capacity;
+                    }
+                    stack[count++] = arr->values[i];
+                }
+                if (!arr->arena) {
+                    free(arr->values);
+                    free(arr);
+                }
+                break;
             }
-            free(arr->values);
-            free(arr);
-            break;
-        }
-        case JSON_OBJECT: {
-            JsonObject* obj = value->data.object_value;
-            for (size_t i = 0; i < obj->count; i++) {
-                free(obj->pairs[i].key);
-                json_free(obj->pairs[i].value);
+            case JSON_OBJECT: {
+                JsonObject* obj = value->data.object_value;
+                for (size_t i = 0; i < obj->count; i++) {
+                    if (!obj->arena && !(obj->pairs[i].flags & JSON_PAIR_KEY_BORROWED)) {
+                        free(obj->pairs[i].key);
+                    }
+                    if (count >= capacity) {
+                        size_t new_capacity = capacity == 0 ? PARSE_STACK_INITIAL : capacity * 2;
+                        JsonValue** grown = realloc(stack, new_capacity * sizeof(JsonValue*));
+                        if (!grown) {
+                            json_free(obj->pairs[i].value);
+                            continue;
+                        }
+                        stack = grown;
+                        capacity = new_capacity;
+                    }
+                    stack[count++] = obj->pairs[i].value;
+                }
+                if (!obj->arena) {
+                    free(obj->hash_index);
+                    free(obj->pairs);
+                    free(obj);
+                }
+                break;
             }
-            free(obj->pairs);
-            free(obj);
-            break;
+            default:
+                break;
         }
-        default:
-            break;
+        if (!(value->flags & JSON_VALUE_FLAG_ARENA)) {
+            free(value);
+        }
+
+        // NULL slots are legal (the move APIs detach children in place)
+        do {
+            if (count == 0) {
+                free(stack);
+                return;
+            }
+            value = stack[--count];
+        } while (!value);
     }
-    free(value);
 }
 
 bool json_array_remove(JsonValue* array, size_t index) {
@@ -1048,22 +1594,74 @@ bool json_object_remove(JsonValue* object, const char* key) {
     }
     
     JsonObject* obj = object->data.object_value;
-    
-    for (size_t i = 0; i < obj->count; i++) {
-        if (strcmp(obj->pairs[i].key, key) == 0) {
-            free(obj->pairs[i].key);
-            json_free(obj->pairs[i].value);
-            
-            for (size_t j = i; j < obj->count - 1; j++) {
-                obj->pairs[j] = obj->pairs[j + 1];
-            }
-            obj->count--;
-            return true;
+
+    size_t i = object_find_pair(obj, key);
+    if (i == (size_t)-1) {
+        json_set_error(JSON_ERROR_KEY_NOT_FOUND, key, 0, 0);
+        return false;
+    }
+
+    if (!obj->arena && !(obj->pairs[i].flags & JSON_PAIR_KEY_BORROWED)) {
+        free(obj->pairs[i].key);
+    }
+    json_free(obj->pairs[i].value);
+
+    for (size_t j = i; j < obj->count - 1; j++) {
+        obj->pairs[j] = obj->pairs[j + 1];
+    }
+    obj->count--;
+
+    // Removal shifts pair indices; rebuild or drop the table
+    if (obj->hash_index) {
+        if (obj->count >= OBJECT_HASH_THRESHOLD) {
+            object_build_index(obj);
+        } else {
+            object_index_release(obj);
         }
     }
-    
-    json_set_error(JSON_ERROR_KEY_NOT_FOUND, key, 0, 0);
-    return false;
+    return true;
+}
+
+// Detach and return the value for a key without freeing it; the caller
+// takes ownership. The pair's key storage is released as in remove.
+JsonValue* json_object_take(JsonValue* object, const char* key) {
+    if (!object || !key) {
+        json_set_error(JSON_ERROR_NULL_POINTER, "Object or key is NULL", 0, 0);
+        return NULL;
+    }
+
+    if (object->type != JSON_OBJECT) {
+        json_set_error(JSON_ERROR_INVALID_TYPE, "Not an object", 0, 0);
+        return NULL;
+    }
+
+    JsonObject* obj = object->data.object_value;
+
+    size_t i = object_find_pair(obj, key);
+    if (i == (size_t)-1) {
+        json_set_error(JSON_ERROR_KEY_NOT_FOUND, key, 0, 0);
+        return NULL;
+    }
+
+    JsonValue* value = obj->pairs[i].value;
+    if (!obj->arena && !(obj->pairs[i].flags & JSON_PAIR_KEY_BORROWED)) {
+        free(obj->pairs[i].key);
+    }
+
+    for (size_t j = i; j < obj->count - 1; j++) {
+        obj->pairs[j] = obj->pairs[j + 1];
+    }
+    obj->count--;
+
+    // Removal shifts pair indices; rebuild or drop the table
+    if (obj->hash_index) {
+        if (obj->count >= OBJECT_HASH_THRESHOLD) {
+            object_build_index(obj);
+        } else {
+            object_index_release(obj);
+        }
+    }
+    return value;
 }
 
 const char** json_object_keys(const JsonValue* object, size_t* count) {
@@ -1097,12 +1695,140 @@ const char** json_object_keys(const JsonValue* object, size_t* count) {
     return keys;
 }
 
+// Structural walk for validate mode: same grammar and error reporting as
+// parse_value, but nothing is materialized — the stack holds one byte per
+// open container (nonzero for objects)
+static bool validate_value_scan(Tokenizer* t) {
+    unsigned char* stack = NULL;
+    size_t depth = 0;
+    size_t capacity = 0;
+    bool ok = false;
+
+value_start:
+    switch (t->current_token.type) {
+        case TOKEN_NULL:
+        case TOKEN_TRUE:
+        case TOKEN_FALSE:
+        case TOKEN_NUMBER:
+        case TOKEN_STRING:
+            goto value_done;
+
+        case TOKEN_LBRACKET:
+        case TOKEN_LBRACE: {
+            bool is_object = t->current_token.type == TOKEN_LBRACE;
+            if (unlikely(depth >= g_max_nesting_depth)) {
+                json_set_error(JSON_ERROR_STACK_OVERFLOW, "Nesting too deep", t->line, t->column);
+                goto out;
+            }
+            if (depth >= capacity) {
+                size_t new_capacity = capacity == 0 ? PARSE_STACK_INITIAL : capacity * 2;
+                unsigned char* grown = realloc(stack, new_capacity);
+                if (unlikely(!grown)) {
+                    json_set_error(JSON_ERROR_OUT_OF_MEMORY, "Failed to grow validation stack", 0, 0);
+                    goto out;
+                }
+                stack = grown;
+                capacity = new_capacity;
+            }
+            stack[depth++] = is_object;
+
+            t->current_token = next_token(t);
+            if (is_object) {
+                if (t->current_token.type == TOKEN_RBRACE) {
+                    depth--;
+                    goto value_done;
+                }
+                goto key_start;
+            }
+            if (t->current_token.type == TOKEN_RBRACKET) {
+                depth--;
+                goto value_done;
+            }
+            goto value_start;
+        }
+
+        case TOKEN_EOF:
+            json_set_error(JSON_ERROR_UNEXPECTED_EOF, "Unexpected end of input", t->line, t->column);
+            goto out;
+        default:
+            json_set_error(JSON_ERROR_UNEXPECTED_TOKEN, "Unexpected token", t->current_token.line, t->current_token.column);
+            goto out;
+    }
+
+value_done:
+    if (depth == 0) {
+        ok = true;
+        goto out;
+    }
+
+    t->current_token = next_token(t);
+    if (t->current_token.type == TOKEN_COMMA) {
+        t->current_token = next_token(t);
+        if (stack[depth - 1]) goto key_start;
+        goto value_start;
+    }
+    if (stack[depth - 1]) {
+        if (likely(t->current_token.type == TOKEN_RBRACE)) {
+            depth--;
+            goto value_done;
+        }
+        json_set_error(JSON_ERROR_UNEXPECTED_TOKEN, "Expected ',' or '}'", t->current_token.line, t->current_token.column);
+        goto out;
+    }
+    if (likely(t->current_token.type == TOKEN_RBRACKET)) {
+        depth--;
+        goto value_done;
+    }
+    json_set_error(JSON_ERROR_UNEXPECTED_TOKEN, "Expected ',' or ']'", t->current_token.line, t->current_token.column);
+    goto out;
+
+key_start:
+    if (unlikely(t->current_token.type != TOKEN_STRING)) {
+        json_set_error(JSON_ERROR_UNEXPECTED_TOKEN, "Expected string key", t->current_token.line, t->current_token.column);
+        goto out;
+    }
+    t->current_token = next_token(t);
+    if (unlikely(t->current_token.type != TOKEN_COLON)) {
+        json_set_error(JSON_ERROR_UNEXPECTED_TOKEN, "Expected ':'", t->current_token.line, t->current_token.column);
+        goto out;
+    }
+    t->current_token = next_token(t);
+    goto value_start;
+
+out:
+    free(stack);
+    return ok;
+}
+
 bool json_validate(const char* json_string) {
     json_clear_error();
-    JsonValue* value = json_parse(json_string);
-    if (value) {
-        json_free(value);
-        return true;
+
+    if (!json_string) {
+        json_set_error(JSON_ERROR_NULL_POINTER, "Input string is NULL", 0, 0);
+        return false;
+    }
+
+    Tokenizer tokenizer = {
+        json_string,
+        json_string,
+        json_string + strlen(json_string),
+        1,
+        0,
+        0,
+        false,
+        true,
+        {TOKEN_ERROR, NULL, 0, 0, 0, {0}}
+    };
+    tokenizer.current_token = next_token(&tokenizer);
+
+    if (!validate_value_scan(&tokenizer)) {
+        return false;
     }
-    return false;
+
+    Token next = next_token(&tokenizer);
+    if (next.type != TOKEN_EOF) {
+        json_set_error(JSON_ERROR_UNEXPECTED_TOKEN, "Extra data after JSON value", next.line, next.column);
+        return false;
+    }
+    return true;
 }
@@ -3,6 +3,7 @@
 
 #include <stddef.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 
 typedef enum {
@@ -81,18 +82,37 @@ typedef struct {
     char* path;
     bool auto_optimize;
     JsonError last_error;
+    void* stmt_cache;
 } JsonSqliteDB;
 
 typedef struct JsonValue JsonValue;
 typedef struct JsonObject JsonObject;
 typedef struct JsonArray JsonArray;
+typedef struct JsonArena JsonArena;
+
+enum {
+    JSON_VALUE_FLAG_ARENA = 1 << 0,
+    JSON_VALUE_FLAG_STRING_VIEW = 1 << 1,
+    JSON_VALUE_FLAG_INLINE_STRING = 1 << 2
+};
+
+// Strings up to this many bytes live inside the value itself (small
+// string optimization) instead of a separate heap allocation. Always
+// read string contents through json_string_value, never the union.
+#define JSON_INLINE_STRING_MAX 15
+
+enum {
+    JSON_PAIR_KEY_BORROWED = 1 << 0
+};
 
 struct JsonValue {
     JsonType type;
+    unsigned char flags;
     union {
         bool bool_value;
         double number_value;
         char* string_value;
+        char inline_string[JSON_INLINE_STRING_MAX + 1];
         JsonArray* array_value;
         JsonObject* object_value;
     } data;
@@ -101,18 +121,24 @@ struct JsonValue {
 typedef struct {
     char* key;
     JsonValue* value;
+    unsigned char flags;
 } JsonPair;
 
 struct JsonObject {
     JsonPair* pairs;
     size_t count;
     size_t capacity;
+    JsonArena* arena;
+    size_t* hash_index;
+    size_t index_capacity;
+    bool sorted;  // pairs ordered by key; lookups use binary search
 };
 
 struct JsonArray {
     JsonValue** values;
     size_t count;
     size_t capacity;
+    JsonArena* arena;
 };
 
 typedef struct JsonStreamParser JsonStreamParser;
@@ -136,7 +162,9 @@ typedef struct {
 
 typedef bool (*JsonStreamCallback)(JsonStreamEvent* event, void* user_data);
 
-extern JsonError g_json_last_error;
+// Thread-local: every thread sees only its own last error, so
+// json_get_last_error and the _r variants need no external locking.
+extern _Thread_local JsonError g_json_last_error;
 
 const char* json_error_message(JsonErrorCode code);
 JsonError* json_get_last_error(void);
@@ -145,18 +173,120 @@ void json_set_error(JsonErrorCode code, const char* message, size_t line, size_t
 
 JsonValue* json_parse(const char* json_string);
 JsonValue* json_parse_with_error(const char* json_string, JsonError* error);
+JsonValue* json_parse_buffer(const char* buffer, size_t length);
+JsonValue* json_parse_insitu(char* buffer);
+JsonValue* json_parse_insitu_with_error(char* buffer, JsonError* error);
+JsonValue* json_parse_parallel(const char* buffer, size_t length, int nthreads);
+
+// Per-thread nesting cap for parse/validate. Traversals use heap-backed
+// stacks, so raising this trades memory, not C stack, for depth; 0 restores
+// the default (1000).
+void json_set_max_depth(size_t depth);
+size_t json_get_max_depth(void);
+
+// Optional hot-path instrumentation. Compile with -DCJSON_STATS to enable;
+// without it the JSON_STAT_* macros expand to nothing and json_get_stats
+// reports zeros. Counters are per-thread, like the error slot.
+typedef struct {
+    uint64_t bytes_tokenized;          // input bytes consumed by the parser
+    uint64_t values_allocated;         // JsonValue allocations (heap or arena)
+    uint64_t whitespace_simd_chunks;   // full 16-byte SIMD strides skipped
+    uint64_t whitespace_scalar_bytes;  // whitespace handled by the scalar tail
+    uint64_t object_lookups;           // object key lookups performed
+    uint64_t object_scan_steps;        // pairs/slots examined across lookups
+    uint64_t stringify_grow_blocks;    // rope blocks chained past the first
+    uint64_t stream_buffer_high_water; // peak streaming accumulation bytes
+} JsonStats;
+
+void json_get_stats(JsonStats* out);
+void json_reset_stats(void);
+
+#ifdef CJSON_STATS
+extern _Thread_local JsonStats g_json_stats;
+#define JSON_STAT_ADD(field, n) (g_json_stats.field += (uint64_t)(n))
+#define JSON_STAT_MAX(field, v) \
+    do { \
+        if ((uint64_t)(v) > g_json_stats.field) g_json_stats.field = (uint64_t)(v); \
+    } while (0)
+#else
+#define JSON_STAT_ADD(field, n) ((void)0)
+#define JSON_STAT_MAX(field, v) ((void)0)
+#endif
+typedef struct {
+    bool pretty;
+    int indent_width;
+    size_t block_size;
+    size_t size_hint;
+} JsonWriteConfig;
+
+typedef bool (*JsonWriteSink)(const char* data, size_t length, void* user_data);
+
 char* json_stringify(const JsonValue* value, bool pretty);
+char* json_stringify_r(const JsonValue* value, bool pretty, JsonError* error);
+char* json_stringify_ex(const JsonValue* value, const JsonWriteConfig* config);
+bool json_stringify_to_sink(const JsonValue* value, const JsonWriteConfig* config,
+                            JsonWriteSink sink, void* sink_data, char** out);
+size_t json_stringify_size_hint(const JsonValue* value);
 void json_free(JsonValue* value);
 
+#define JSON_NUMBER_BUFFER_SIZE 40
+
+size_t json_number_format(double value, char* buffer);
+bool json_number_parse(const char* start, const char* end, double* out);
+
+JsonArena* json_arena_create(size_t block_size);
+void json_arena_destroy(JsonArena* arena);
+void json_arena_reset(JsonArena* arena);
+void* json_arena_alloc(JsonArena* arena, size_t size);
+void* json_arena_grow(JsonArena* arena, void* ptr, size_t old_size, size_t new_size);
+char* json_arena_strdup(JsonArena* arena, const char* str);
+size_t json_arena_memory_usage(const JsonArena* arena);
+JsonArena* json_arena_active(void);
+JsonArena* json_arena_activate(JsonArena* arena);
+void json_arena_enable_interning(JsonArena* arena);
+const char* json_arena_intern(JsonArena* arena, const char* str);
+JsonValue* json_parse_arena(const char* json_string, JsonArena* arena);
+JsonValue* json_parse_arena_with_error(const char* json_string, JsonArena* arena, JsonError* error);
+
 JsonStreamParser* json_stream_parser_create(JsonStreamCallback callback, void* user_data);
 bool json_stream_parse_chunk(JsonStreamParser* parser, const char* chunk, size_t length);
 bool json_stream_parse_file(JsonStreamParser* parser, const char* filename);
+bool json_stream_parse_file_r(JsonStreamParser* parser, const char* filename, JsonError* error);
 void json_stream_parser_free(JsonStreamParser* parser);
 
+typedef struct JsonStreamReader JsonStreamReader;
+
+typedef struct JsonDoc JsonDoc;
+
+JsonDoc* json_doc_open(const char* buffer, size_t length);
+JsonValue* json_doc_find(const JsonDoc* doc, const char* key);
+void json_doc_close(JsonDoc* doc);
+
+// Columnar (struct-of-arrays) view of an array of identically-shaped
+// records: per-key typed columns instead of per-element object nodes.
+typedef struct JsonColumnSet JsonColumnSet;
+
+JsonColumnSet* json_columnar_from_array(const JsonValue* array);
+size_t json_columnar_row_count(const JsonColumnSet* set);
+size_t json_columnar_column_count(const JsonColumnSet* set);
+const char* json_columnar_key(const JsonColumnSet* set, size_t column);
+const double* json_columnar_numbers(const JsonColumnSet* set, const char* key);
+const unsigned char* json_columnar_bools(const JsonColumnSet* set, const char* key);
+const char* json_columnar_string_at(const JsonColumnSet* set, const char* key, size_t row);
+bool json_columnar_is_null(const JsonColumnSet* set, const char* key, size_t row);
+JsonValue* json_columnar_row(const JsonColumnSet* set, size_t row);
+void json_columnar_free(JsonColumnSet* set);
+
+JsonStreamReader* json_stream_reader_open(const char* filename);
+JsonValue* json_stream_next(JsonStreamReader* reader);
+bool json_stream_reader_failed(const JsonStreamReader* reader);
+void json_stream_reader_close(JsonStreamReader* reader);
+
 JsonValue* json_create_null(void);
 JsonValue* json_create_bool(bool value);
 JsonValue* json_create_number(double value);
 JsonValue* json_create_string(const char* value);
+const char* json_string_value(const JsonValue* value);
 JsonValue* json_create_array(void);
 JsonValue* json_create_object(void);
 
@@ -166,9 +296,12 @@ bool json_array_remove(JsonValue* array, size_t index);
 size_t json_array_size(const JsonValue* array);
 
 bool json_object_set(JsonValue* object, const char* key, JsonValue* value);
+bool json_object_set_many(JsonValue* object, const char** keys, JsonValue** values, size_t count);
+bool json_object_sort_keys(JsonValue* object);
 JsonValue* json_object_get(const JsonValue* object, const char* key);
 bool json_object_has(const JsonValue* object, const char* key);
 bool json_object_remove(JsonValue* object, const char* key);
+JsonValue* json_object_take(JsonValue* object, const char* key);
 size_t json_object_size(const JsonValue* object);
 const char** json_object_keys(const JsonValue* object, size_t* count);
 
@@ -182,37 +315,99 @@ bool json_is_object(const JsonValue* value);
 char* json_to_xml(const JsonValue* value);
 char* json_to_yaml(const JsonValue* value);
 char* json_to_csv(const JsonValue* value);
+char* json_to_csv_r(const JsonValue* value, JsonError* error);
 char* json_to_ini(const JsonValue* value);
 
 bool json_validate(const char* json_string);
 JsonValue* json_merge(const JsonValue* obj1, const JsonValue* obj2);
+JsonValue* json_merge_move(JsonValue* obj1, JsonValue* obj2);
+bool json_array_concat_move(JsonValue* dst, JsonValue* src);
 JsonValue* json_deep_copy(const JsonValue* value);
 bool json_equals(const JsonValue* val1, const JsonValue* val2);
 
+// Structural hash: equal values (per json_equals) hash equal, so object
+// key order does not matter. The cache variant memoizes container hashes
+// by node pointer; it must not outlive mutations to the hashed trees.
+uint64_t json_hash(const JsonValue* value);
+
+typedef struct JsonHashCache JsonHashCache;
+
+JsonHashCache* json_hash_cache_create(void);
+uint64_t json_hash_cached(const JsonValue* value, JsonHashCache* cache);
+void json_hash_cache_free(JsonHashCache* cache);
+
+typedef struct {
+    char* data;
+    size_t size;
+} JsonMappedFile;
+
 JsonValue* json_parse_file(const char* filename);
+JsonValue* json_parse_file_r(const char* filename, JsonError* error);
+JsonValue* json_parse_file_limit(const char* filename, size_t max_size);
+JsonValue* json_parse_file_mmap(const char* filename);
+bool json_mmap_open(const char* filename, JsonMappedFile* map);
+void json_mmap_close(JsonMappedFile* map);
 bool json_save_file(const char* filename, const JsonValue* value, bool pretty);
+bool json_save_file_r(const char* filename, const JsonValue* value, bool pretty, JsonError* error);
+bool json_write_file(const char* filename, const JsonValue* value, bool pretty);
+bool json_write_stream(FILE* file, const JsonValue* value, bool pretty);
+bool json_save_binary(const char* filename, const JsonValue* value);
+JsonValue* json_load_binary(const char* filename);
 
 JsonValue* xml_to_json(const char* xml);
 JsonValue* yaml_to_json(const char* yaml);
 JsonValue* csv_to_json(const char* csv);
+JsonValue* csv_to_json_r(const char* csv, JsonError* error);
+
+// Row callback for streaming CSV conversion. The row object is backed
+// by a recycled arena and is only valid for the duration of the call;
+// return false to stop iteration early.
+typedef bool (*JsonCsvRowCallback)(JsonValue* row, size_t row_index, void* user_data);
+
+bool csv_file_to_json_stream(const char* filename, JsonCsvRowCallback callback, void* user_data);
+bool json_array_to_csv_file(const JsonValue* value, const char* filename);
 JsonValue* ini_to_json(const char* ini);
 
 JsonSqliteDB* json_to_sqlite(const JsonValue* value, const char* db_path);
 JsonValue* sqlite_to_json(const char* db_path, const char* table_name);
 bool sqlite_insert(JsonSqliteDB* db, const char* table, const JsonValue* value);
+bool sqlite_insert_batch(JsonSqliteDB* db, const char* table, const JsonValue* array);
 JsonValue* sqlite_query(JsonSqliteDB* db, const char* table, const char* key, const char* value);
 JsonValue* sqlite_get_all(JsonSqliteDB* db, const char* table);
+
+// Streaming table export: batches are arena-backed and recycled on each
+// next_batch call, so memory stays constant regardless of table size.
+typedef struct SqliteJsonCursor SqliteJsonCursor;
+
+SqliteJsonCursor* sqlite_cursor_open(JsonSqliteDB* db, const char* table);
+JsonValue* sqlite_cursor_next_batch(SqliteJsonCursor* cursor, size_t n);
+bool sqlite_cursor_failed(const SqliteJsonCursor* cursor);
+void sqlite_cursor_close(SqliteJsonCursor* cursor);
 bool sqlite_update(JsonSqliteDB* db, const char* table, const char* key, const char* key_value, const JsonValue* new_data);
 bool sqlite_delete(JsonSqliteDB* db, const char* table, const char* key, const char* value);
 void sqlite_optimize(JsonSqliteDB* db);
 void sqlite_close(JsonSqliteDB* db);
 
+typedef struct JsonPathExpr JsonPathExpr;
+
+typedef struct JsonSchema JsonSchema;
+
+JsonSchema* json_schema_compile(const JsonValue* schema);
+bool json_schema_validate(const JsonSchema* schema, const JsonValue* data, JsonError* error);
+void json_schema_free(JsonSchema* schema);
+
 JsonValue* json_path_query(const JsonValue* root, const char* path);
+JsonPathExpr* json_path_compile(const char* path);
+JsonValue* json_path_exec(const JsonPathExpr* expr, const JsonValue* root);
+void json_path_expr_free(JsonPathExpr* expr);
 bool json_validate_schema(const JsonValue* data, const JsonValue* schema);
 JsonValue* json_diff(const JsonValue* val1, const JsonValue* val2);
+JsonValue* json_diff_deep(const JsonValue* val1, const JsonValue* val2);
 JsonValue* json_patch(JsonValue* target, const JsonValue* patch);
+JsonValue* json_patch_inplace(JsonValue* target, JsonValue* patch);
 size_t json_memory_usage(const JsonValue* value);
 void json_optimize_memory(JsonValue* value);
+void json_optimize_memory_ex(JsonValue* value, bool sort_keys);
 
 void run_all_benchmarks(void);
 
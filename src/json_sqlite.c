@@ -6,6 +6,75 @@
 #include <ctype.h>
 #include <sqlite3.h>
 
+// Prepared-statement cache: one compiled INSERT per (table, column-set),
+// keyed by a "table|col1,col2,..." signature so the same statement is
+// reused across rows instead of re-parsing SQL text for each record
+#define STMT_CACHE_SIZE 16
+
+typedef struct {
+    char* signature;
+    sqlite3_stmt* stmt;
+    unsigned last_used;
+} CachedStmt;
+
+typedef struct {
+    CachedStmt entries[STMT_CACHE_SIZE];
+    unsigned clock;
+} StmtCache;
+
+static StmtCache* stmt_cache_get(JsonSqliteDB* db) {
+    if (!db->stmt_cache) {
+        db->stmt_cache = calloc(1, sizeof(StmtCache));
+    }
+    return db->stmt_cache;
+}
+
+static void stmt_cache_free(JsonSqliteDB* db) {
+    StmtCache* cache = db->stmt_cache;
+    if (!cache) return;
+
+    for (int i = 0; i < STMT_CACHE_SIZE; i++) {
+        if (cache->entries[i].stmt) {
+            sqlite3_finalize(cache->entries[i].stmt);
+        }
+        free(cache->entries[i].signature);
+    }
+    free(cache);
+    db->stmt_cache = NULL;
+}
+
+static sqlite3_stmt* stmt_cache_lookup(StmtCache* cache, const char* signature) {
+    for (int i = 0; i < STMT_CACHE_SIZE; i++) {
+        if (cache->entries[i].signature &&
+            strcmp(cache->entries[i].signature, signature) == 0) {
+            cache->entries[i].last_used = ++cache->clock;
+            return cache->entries[i].stmt;
+        }
+    }
+    return NULL;
+}
+
+static void stmt_cache_insert(StmtCache* cache, char* signature, sqlite3_stmt* stmt) {
+    int slot = 0;
+    for (int i = 0; i < STMT_CACHE_SIZE; i++) {
+        if (!cache->entries[i].stmt) {
+            slot = i;
+            break;
+        }
+        if (cache->entries[i].last_used < cache->entries[slot].last_used) {
+            slot = i;
+        }
+    }
+
+    if (cache->entries[slot].stmt) {
+        sqlite3_finalize(cache->entries[slot].stmt);
+        free(cache->entries[slot].signature);
+    }
+    cache->entries[slot].signature = signature;
+    cache->entries[slot].stmt = stmt;
+    cache->entries[slot].last_used = ++cache->clock;
+}
+
 static char* sanitize_name(const char* name) {
     if (!name) {
         json_set_error(JSON_ERROR_NULL_POINTER, "Table/column name is NULL", 0, 0);
@@ -195,59 +264,27 @@ JsonSqliteDB* json_to_sqlite(const JsonValue* value, const char* db_path) {
         err_msg = NULL;
     }
     
+    JsonSqliteDB* result = malloc(sizeof(JsonSqliteDB));
+    if (!result) {
+        json_set_error(JSON_ERROR_OUT_OF_MEMORY, "Failed to allocate database handle", 0, 0);
+        sqlite3_close(db);
+        return NULL;
+    }
+    result->db = db;
+    result->path = malloc(strlen(db_path) + 1);
+    strcpy(result->path, db_path);
+    result->auto_optimize = true;
+    result->stmt_cache = NULL;
+
     if (value->type == JSON_ARRAY) {
         JsonArray* arr = value->data.array_value;
         if (arr->count > 0 && arr->values[0]->type == JSON_OBJECT) {
             create_table_from_json(db, "data", arr->values[0]);
-            
-            sqlite3_exec(db, "BEGIN TRANSACTION", NULL, NULL, NULL);
-            
-            for (size_t i = 0; i < arr->count; i++) {
-                if (arr->values[i]->type != JSON_OBJECT) continue;
-                
-                JsonObject* obj = arr->values[i]->data.object_value;
-                char query[4096] = "INSERT INTO data (";
-                char values[4096] = " VALUES (";
-                
-                for (size_t j = 0; j < obj->count; j++) {
-                    char* safe_col = sanitize_name(obj->pairs[j].key);
-                    strcat(query, safe_col);
-                    free(safe_col);
-                    
-                    if (j < obj->count - 1) strcat(query, ", ");
-                }
-                strcat(query, ")");
-                
-                for (size_t j = 0; j < obj->count; j++) {
-                    JsonValue* val = obj->pairs[j].value;
-                    
-                    if (val->type == JSON_STRING) {
-                        strcat(values, "'");
-                        strcat(values, val->data.string_value);
-                        strcat(values, "'");
-                    } else if (val->type == JSON_NUMBER) {
-                        char num[64];
-                        snprintf(num, sizeof(num), "%g", val->data.number_value);
-                        strcat(values, num);
-                    } else if (val->type == JSON_BOOL) {
-                        strcat(values, val->data.bool_value ? "1" : "0");
-                    } else {
-                        strcat(values, "NULL");
-                    }
-                    
-                    if (j < obj->count - 1) strcat(values, ", ");
-                }
-                strcat(values, ")");
-                strcat(query, values);
-                
-                sqlite3_exec(db, query, NULL, NULL, NULL);
-            }
-            
-            sqlite3_exec(db, "COMMIT", NULL, NULL, NULL);
+            sqlite_insert_batch(result, "data", value);
         }
     } else if (value->type == JSON_OBJECT) {
         JsonObject* root = value->data.object_value;
-        
+
         for (size_t i = 0; i < root->count; i++) {
             if (root->pairs[i].value->type == JSON_ARRAY) {
                 JsonArray* arr = root->pairs[i].value->data.array_value;
@@ -257,13 +294,7 @@ JsonSqliteDB* json_to_sqlite(const JsonValue* value, const char* db_path) {
             }
         }
     }
-    
-    JsonSqliteDB* result = malloc(sizeof(JsonSqliteDB));
-    result->db = db;
-    result->path = malloc(strlen(db_path) + 1);
-    strcpy(result->path, db_path);
-    result->auto_optimize = true;
-    
+
     return result;
 }
 
@@ -380,96 +411,116 @@ JsonValue* sqlite_to_json(const char* db_path, const char* table_name) {
     return array;
 }
 
-bool sqlite_insert(JsonSqliteDB* db, const char* table, const JsonValue* value) {
-    if (!db) {
-        json_set_error(JSON_ERROR_NULL_POINTER, "Database handle is NULL", 0, 0);
-        return false;
+// Returns a cached prepared INSERT for this (table, column-set), compiling
+// and caching it on first use. The statement stays owned by the cache.
+static sqlite3_stmt* prepare_insert_stmt(JsonSqliteDB* db, const char* table, const JsonObject* obj) {
+    char* safe_table = sanitize_name(table);
+    if (!safe_table) {
+        json_set_error(JSON_ERROR_OUT_OF_MEMORY, "Failed to sanitize table name", 0, 0);
+        return NULL;
     }
-    
-    if (!table) {
-        json_set_error(JSON_ERROR_NULL_POINTER, "Table name is NULL", 0, 0);
-        return false;
+
+    size_t sig_len = strlen(safe_table) + 2;
+    for (size_t i = 0; i < obj->count; i++) {
+        sig_len += strlen(obj->pairs[i].key) + 1;
     }
-    
-    if (!value) {
-        json_set_error(JSON_ERROR_NULL_POINTER, "Value to insert is NULL", 0, 0);
-        return false;
+
+    char* signature = malloc(sig_len);
+    if (!signature) {
+        free(safe_table);
+        json_set_error(JSON_ERROR_OUT_OF_MEMORY, "Failed to allocate statement signature", 0, 0);
+        return NULL;
     }
-    
-    if (value->type != JSON_OBJECT) {
-        json_set_error(JSON_ERROR_INVALID_TYPE, "Value must be a JSON object", 0, 0);
-        return false;
+
+    size_t pos = (size_t)snprintf(signature, sig_len, "%s|", safe_table);
+    for (size_t i = 0; i < obj->count; i++) {
+        size_t key_len = strlen(obj->pairs[i].key);
+        memcpy(signature + pos, obj->pairs[i].key, key_len);
+        pos += key_len;
+        signature[pos++] = ',';
     }
-    
-    JsonObject* obj = value->data.object_value;
-    
-    if (obj->count == 0) {
-        json_set_error(JSON_ERROR_INVALID_TYPE, "Cannot insert empty object", 0, 0);
-        return false;
+    signature[pos] = '\0';
+
+    StmtCache* cache = stmt_cache_get(db);
+    if (cache) {
+        sqlite3_stmt* cached = stmt_cache_lookup(cache, signature);
+        if (cached) {
+            free(signature);
+            free(safe_table);
+            return cached;
+        }
     }
-    
+
     char query[4096] = "INSERT INTO ";
-    char* safe_table = sanitize_name(table);
-    
-    if (!safe_table) {
-        json_set_error(JSON_ERROR_OUT_OF_MEMORY, "Failed to sanitize table name", 0, 0);
-        return false;
-    }
-    
     if (strlen(query) + strlen(safe_table) + 10 >= sizeof(query)) {
+        free(signature);
         free(safe_table);
         json_set_error(JSON_ERROR_SQLITE_ERROR, "Query buffer too small", 0, 0);
-        return false;
+        return NULL;
     }
-    
+
     strcat(query, safe_table);
     strcat(query, " (");
     free(safe_table);
-    
+
     for (size_t i = 0; i < obj->count; i++) {
         char* safe_col = sanitize_name(obj->pairs[i].key);
         if (!safe_col) {
+            free(signature);
             json_set_error(JSON_ERROR_OUT_OF_MEMORY, "Failed to sanitize column name", 0, 0);
-            return false;
+            return NULL;
         }
-        
+
         if (strlen(query) + strlen(safe_col) + 10 >= sizeof(query)) {
             free(safe_col);
+            free(signature);
             json_set_error(JSON_ERROR_SQLITE_ERROR, "Query buffer overflow", 0, 0);
-            return false;
+            return NULL;
         }
-        
+
         strcat(query, safe_col);
         free(safe_col);
         if (i < obj->count - 1) strcat(query, ", ");
     }
     strcat(query, ") VALUES (");
-    
+
     for (size_t i = 0; i < obj->count; i++) {
         strcat(query, "?");
         if (i < obj->count - 1) strcat(query, ", ");
     }
     strcat(query, ")");
-    
+
     sqlite3_stmt* stmt;
     int rc = sqlite3_prepare_v2(db->db, query, -1, &stmt, NULL);
     if (rc != SQLITE_OK) {
         char error_msg[512];
         snprintf(error_msg, sizeof(error_msg), "Failed to prepare statement: %s", sqlite3_errmsg(db->db));
         json_set_error(JSON_ERROR_SQLITE_ERROR, error_msg, 0, 0);
-        return false;
+        free(signature);
+        return NULL;
     }
-    
+
+    if (cache) {
+        stmt_cache_insert(cache, signature, stmt);
+    } else {
+        free(signature);
+    }
+    return stmt;
+}
+
+// Bind one row against a cached statement, execute it and reset it for
+// the next row. Values bind directly from the JsonValue, no SQL text.
+static bool insert_bind_and_step(JsonSqliteDB* db, sqlite3_stmt* stmt, const JsonObject* obj) {
     for (size_t i = 0; i < obj->count; i++) {
         JsonValue* val = obj->pairs[i].value;
         int bind_rc = SQLITE_OK;
-        
+
         switch (val->type) {
             case JSON_NUMBER:
                 bind_rc = sqlite3_bind_double(stmt, i + 1, val->data.number_value);
                 break;
             case JSON_STRING:
-                bind_rc = sqlite3_bind_text(stmt, i + 1, val->data.string_value, -1, SQLITE_TRANSIENT);
+                bind_rc = sqlite3_bind_text(stmt, i + 1, json_string_value(val), -1, SQLITE_STATIC);
                 break;
             case JSON_BOOL:
                 bind_rc = sqlite3_bind_int(stmt, i + 1, val->data.bool_value ? 1 : 0);
@@ -478,37 +529,177 @@ bool sqlite_insert(JsonSqliteDB* db, const char* table, const JsonValue* value)
                 bind_rc = sqlite3_bind_null(stmt, i + 1);
                 break;
         }
-        
+
         if (bind_rc != SQLITE_OK) {
             char error_msg[512];
             snprintf(error_msg, sizeof(error_msg), "Failed to bind parameter %zu: %s", i, sqlite3_errmsg(db->db));
             json_set_error(JSON_ERROR_SQLITE_ERROR, error_msg, 0, 0);
-            sqlite3_finalize(stmt);
+            sqlite3_reset(stmt);
+            sqlite3_clear_bindings(stmt);
             return false;
         }
     }
-    
-    rc = sqlite3_step(stmt);
-    bool success = (rc == SQLITE_DONE);
-    
-    if (!success) {
+
+    int rc = sqlite3_step(stmt);
+    sqlite3_reset(stmt);
+    sqlite3_clear_bindings(stmt);
+
+    if (rc != SQLITE_DONE) {
         char error_msg[512];
         snprintf(error_msg, sizeof(error_msg), "Insert failed: %s", sqlite3_errmsg(db->db));
         json_set_error(JSON_ERROR_SQLITE_ERROR, error_msg, 0, 0);
+        return false;
     }
-    
-    sqlite3_finalize(stmt);
-    
+    return true;
+}
+
+static bool insert_object_row(JsonSqliteDB* db, const char* table, const JsonValue* value) {
+    JsonObject* obj = value->data.object_value;
+
+    if (obj->count == 0) {
+        json_set_error(JSON_ERROR_INVALID_TYPE, "Cannot insert empty object", 0, 0);
+        return false;
+    }
+
+    sqlite3_stmt* stmt = prepare_insert_stmt(db, table, obj);
+    if (!stmt) return false;
+
+    return insert_bind_and_step(db, stmt, obj);
+}
+
+bool sqlite_insert(JsonSqliteDB* db, const char* table, const JsonValue* value) {
+    if (!db) {
+        json_set_error(JSON_ERROR_NULL_POINTER, "Database handle is NULL", 0, 0);
+        return false;
+    }
+
+    if (!table) {
+        json_set_error(JSON_ERROR_NULL_POINTER, "Table name is NULL", 0, 0);
+        return false;
+    }
+
+    if (!value) {
+        json_set_error(JSON_ERROR_NULL_POINTER, "Value to insert is NULL", 0, 0);
+        return false;
+    }
+
+    if (value->type != JSON_OBJECT) {
+        json_set_error(JSON_ERROR_INVALID_TYPE, "Value must be a JSON object", 0, 0);
+        return false;
+    }
+
+    bool success = insert_object_row(db, table, value);
+
     if (success && db->auto_optimize) {
         static int insert_count = 0;
         if (++insert_count % 1000 == 0) {
             sqlite_optimize(db);
         }
     }
-    
+
     return success;
 }
 
+#define SQLITE_BATCH_ROWS 10000
+
+bool sqlite_insert_batch(JsonSqliteDB* db, const char* table, const JsonValue* array) {
+    if (!db || !table || !array) {
+        json_set_error(JSON_ERROR_NULL_POINTER, "Invalid NULL argument to sqlite_insert_batch", 0, 0);
+        return false;
+    }
+
+    if (array->type != JSON_ARRAY) {
+        json_set_error(JSON_ERROR_INVALID_TYPE, "Batch insert needs a JSON array", 0, 0);
+        return false;
+    }
+
+    JsonArray* arr = array->data.array_value;
+    bool in_transaction = false;
+    size_t pending = 0;
+
+    for (size_t i = 0; i < arr->count; i++) {
+        if (arr->values[i]->type != JSON_OBJECT) continue;
+
+        if (!in_transaction) {
+            if (sqlite3_exec(db->db, "BEGIN TRANSACTION", NULL, NULL, NULL) != SQLITE_OK) {
+                json_set_error(JSON_ERROR_SQLITE_ERROR, "Failed to begin transaction", 0, 0);
+                return false;
+            }
+            in_transaction = true;
+        }
+
+        if (!insert_object_row(db, table, arr->values[i])) {
+            sqlite3_exec(db->db, "ROLLBACK", NULL, NULL, NULL);
+            return false;
+        }
+
+        if (++pending >= SQLITE_BATCH_ROWS) {
+            sqlite3_exec(db->db, "COMMIT", NULL, NULL, NULL);
+            in_transaction = false;
+            pending = 0;
+        }
+    }
+
+    if (in_transaction) {
+        sqlite3_exec(db->db, "COMMIT", NULL, NULL, NULL);
+    }
+    return true;
+}
+
+// Materialize every remaining row of a prepared statement into the given
+// array; shared by sqlite_query and sqlite_get_all
+static JsonValue* read_all_rows(JsonSqliteDB* db, sqlite3_stmt* stmt, JsonValue* array) {
+    int col_count = sqlite3_column_count(stmt);
+    int rc;
+
+    while ((rc = sqlite3_step(stmt)) == SQLITE_ROW) {
+        JsonValue* obj = json_create_object();
+        if (!obj) {
+            json_free(array);
+            return NULL;
+        }
+
+        for (int i = 0; i < col_count; i++) {
+            const char* col_name = sqlite3_column_name(stmt, i);
+            if (!col_name) continue;
+
+            int col_type = sqlite3_column_type(stmt, i);
+
+            JsonValue* val = NULL;
+            switch (col_type) {
+                case SQLITE_INTEGER:
+                    val = json_create_number(sqlite3_column_int(stmt, i));
+                    break;
+                case SQLITE_FLOAT:
+                    val = json_create_number(sqlite3_column_double(stmt, i));
+                    break;
+                case SQLITE_TEXT: {
+                    const char* text = (const char*)sqlite3_column_text(stmt, i);
+                    val = json_create_string(text ? text : "");
+                    break;
+                }
+                default:
+                    val = json_create_null();
+                    break;
+            }
+
+            if (val) {
+                json_object_set(obj, col_name, val);
+            }
+        }
+
+        json_array_append(array, obj);
+    }
+
+    if (rc != SQLITE_DONE) {
+        char error_msg[512];
+        snprintf(error_msg, sizeof(error_msg), "Query execution error: %s", sqlite3_errmsg(db->db));
+        json_set_error(JSON_ERROR_SQLITE_ERROR, error_msg, 0, 0);
+    }
+
+    return array;
+}
+
 JsonValue* sqlite_query(JsonSqliteDB* db, const char* table, const char* key, const char* value) {
     if (!db) {
         json_set_error(JSON_ERROR_NULL_POINTER, "Database handle is NULL", 0, 0);
@@ -566,32 +757,172 @@ JsonValue* sqlite_query(JsonSqliteDB* db, const char* table, const char* key, co
         return NULL;
     }
     
-    int col_count = sqlite3_column_count(stmt);
-    
-    while ((rc = sqlite3_step(stmt)) == SQLITE_ROW) {
-        JsonValue* obj = json_create_object();
-        if (!obj) {
-            sqlite3_finalize(stmt);
-            json_free(array);
+    JsonValue* result = read_all_rows(db, stmt, array);
+    sqlite3_finalize(stmt);
+    return result;
+}
+
+JsonValue* sqlite_get_all(JsonSqliteDB* db, const char* table) {
+    if (!db || !table) {
+        json_set_error(JSON_ERROR_NULL_POINTER, "Database handle or table is NULL", 0, 0);
+        return NULL;
+    }
+
+    char query[256];
+    char* safe_table = sanitize_name(table);
+    if (!safe_table) {
+        json_set_error(JSON_ERROR_OUT_OF_MEMORY, "Failed to sanitize table name", 0, 0);
+        return NULL;
+    }
+
+    int written = snprintf(query, sizeof(query), "SELECT * FROM %s", safe_table);
+    free(safe_table);
+
+    if (written >= (int)sizeof(query)) {
+        json_set_error(JSON_ERROR_SQLITE_ERROR, "Query too long", 0, 0);
+        return NULL;
+    }
+
+    sqlite3_stmt* stmt;
+    // Query through the live connection: reopening by path used to
+    // deadlock against our own EXCLUSIVE locking mode
+    int rc = sqlite3_prepare_v2(db->db, query, -1, &stmt, NULL);
+    if (rc != SQLITE_OK) {
+        char error_msg[512];
+        snprintf(error_msg, sizeof(error_msg), "Failed to prepare query: %s", sqlite3_errmsg(db->db));
+        json_set_error(JSON_ERROR_SQLITE_ERROR, error_msg, 0, 0);
+        return NULL;
+    }
+
+    JsonValue* array = json_create_array();
+    if (!array) {
+        sqlite3_finalize(stmt);
+        return NULL;
+    }
+
+    JsonValue* result = read_all_rows(db, stmt, array);
+    sqlite3_finalize(stmt);
+    return result;
+}
+
+// ---------------------------------------------------------------------------
+// Streaming cursor: constant-memory table export. Each next_batch call
+// recycles the cursor's arena, so a batch is valid only until the next
+// call (or close). Column names are cached once at open instead of being
+// fetched per cell, and every value in a batch is arena-allocated with
+// interned keys — no per-cell heap allocations.
+// ---------------------------------------------------------------------------
+
+struct SqliteJsonCursor {
+    JsonSqliteDB* db;
+    sqlite3_stmt* stmt;
+    JsonArena* arena;
+    char** column_names;
+    int column_count;
+    bool done;
+    bool failed;
+};
+
+SqliteJsonCursor* sqlite_cursor_open(JsonSqliteDB* db, const char* table) {
+    if (!db || !table) {
+        json_set_error(JSON_ERROR_NULL_POINTER, "Database handle or table is NULL", 0, 0);
+        return NULL;
+    }
+
+    char query[256];
+    char* safe_table = sanitize_name(table);
+    if (!safe_table) {
+        json_set_error(JSON_ERROR_OUT_OF_MEMORY, "Failed to sanitize table name", 0, 0);
+        return NULL;
+    }
+
+    int written = snprintf(query, sizeof(query), "SELECT * FROM %s", safe_table);
+    free(safe_table);
+    if (written >= (int)sizeof(query)) {
+        json_set_error(JSON_ERROR_SQLITE_ERROR, "Query too long", 0, 0);
+        return NULL;
+    }
+
+    sqlite3_stmt* stmt;
+    int rc = sqlite3_prepare_v2(db->db, query, -1, &stmt, NULL);
+    if (rc != SQLITE_OK) {
+        char error_msg[512];
+        snprintf(error_msg, sizeof(error_msg), "Failed to prepare query: %s", sqlite3_errmsg(db->db));
+        json_set_error(JSON_ERROR_SQLITE_ERROR, error_msg, 0, 0);
+        return NULL;
+    }
+
+    SqliteJsonCursor* cursor = calloc(1, sizeof(SqliteJsonCursor));
+    if (!cursor) {
+        sqlite3_finalize(stmt);
+        json_set_error(JSON_ERROR_OUT_OF_MEMORY, "Failed to allocate cursor", 0, 0);
+        return NULL;
+    }
+
+    cursor->db = db;
+    cursor->stmt = stmt;
+    cursor->column_count = sqlite3_column_count(stmt);
+    cursor->arena = json_arena_create(0);
+    cursor->column_names = calloc(cursor->column_count > 0 ? cursor->column_count : 1,
+                                  sizeof(char*));
+    if (!cursor->arena || !cursor->column_names) {
+        sqlite_cursor_close(cursor);
+        json_set_error(JSON_ERROR_OUT_OF_MEMORY, "Failed to allocate cursor", 0, 0);
+        return NULL;
+    }
+    json_arena_enable_interning(cursor->arena);
+
+    for (int i = 0; i < cursor->column_count; i++) {
+        const char* name = sqlite3_column_name(stmt, i);
+        cursor->column_names[i] = json_arena_strdup(NULL, name ? name : "");
+        if (!cursor->column_names[i]) {
+            sqlite_cursor_close(cursor);
+            json_set_error(JSON_ERROR_OUT_OF_MEMORY, "Failed to cache column names", 0, 0);
             return NULL;
         }
-        
-        for (int i = 0; i < col_count; i++) {
-            const char* col_name = sqlite3_column_name(stmt, i);
-            if (!col_name) continue;
-            
-            int col_type = sqlite3_column_type(stmt, i);
-            
-            JsonValue* val = NULL;
-            switch (col_type) {
+    }
+
+    return cursor;
+}
+
+// Fetch up to n rows as an arena-backed array of objects. Returns NULL
+// when the table is exhausted (sqlite_cursor_failed distinguishes errors).
+// The returned array and everything in it dies on the next call.
+JsonValue* sqlite_cursor_next_batch(SqliteJsonCursor* cursor, size_t n) {
+    if (!cursor) {
+        json_set_error(JSON_ERROR_NULL_POINTER, "Cursor is NULL", 0, 0);
+        return NULL;
+    }
+    if (cursor->done || cursor->failed || n == 0) return NULL;
+
+    // Recycle the arena: the previous batch dies here
+    json_arena_reset(cursor->arena);
+    JsonArena* previous = json_arena_activate(cursor->arena);
+
+    JsonValue* batch = json_create_array();
+    if (!batch) {
+        json_arena_activate(previous);
+        cursor->failed = true;
+        return NULL;
+    }
+
+    size_t rows = 0;
+    int rc;
+    while (rows < n && (rc = sqlite3_step(cursor->stmt)) == SQLITE_ROW) {
+        JsonValue* obj = json_create_object();
+        if (!obj) goto batch_error;
+
+        for (int i = 0; i < cursor->column_count; i++) {
+            JsonValue* val;
+            switch (sqlite3_column_type(cursor->stmt, i)) {
                 case SQLITE_INTEGER:
-                    val = json_create_number(sqlite3_column_int(stmt, i));
+                    val = json_create_number(sqlite3_column_int(cursor->stmt, i));
                     break;
                 case SQLITE_FLOAT:
-                    val = json_create_number(sqlite3_column_double(stmt, i));
+                    val = json_create_number(sqlite3_column_double(cursor->stmt, i));
                     break;
                 case SQLITE_TEXT: {
-                    const char* text = (const char*)sqlite3_column_text(stmt, i);
+                    const char* text = (const char*)sqlite3_column_text(cursor->stmt, i);
                     val = json_create_string(text ? text : "");
                     break;
                 }
@@ -599,27 +930,51 @@ JsonValue* sqlite_query(JsonSqliteDB* db, const char* table, const char* key, co
                     val = json_create_null();
                     break;
             }
-            
-            if (val) {
-                json_object_set(obj, col_name, val);
+            if (!val || !json_object_set(obj, cursor->column_names[i], val)) {
+                goto batch_error;
             }
         }
-        
-        json_array_append(array, obj);
+
+        if (!json_array_append(batch, obj)) goto batch_error;
+        rows++;
     }
-    
-    if (rc != SQLITE_DONE && rc != SQLITE_ROW) {
-        char error_msg[512];
-        snprintf(error_msg, sizeof(error_msg), "Query execution error: %s", sqlite3_errmsg(db->db));
-        json_set_error(JSON_ERROR_SQLITE_ERROR, error_msg, 0, 0);
+
+    json_arena_activate(previous);
+
+    if (rows < n) {
+        cursor->done = true;
+        if (rc != SQLITE_DONE) {
+            char error_msg[512];
+            snprintf(error_msg, sizeof(error_msg), "Query execution error: %s", sqlite3_errmsg(cursor->db->db));
+            json_set_error(JSON_ERROR_SQLITE_ERROR, error_msg, 0, 0);
+            cursor->failed = true;
+            return NULL;
+        }
     }
-    
-    sqlite3_finalize(stmt);
-    return array;
+
+    return rows > 0 ? batch : NULL;
+
+batch_error:
+    json_arena_activate(previous);
+    cursor->failed = true;
+    return NULL;
 }
 
-JsonValue* sqlite_get_all(JsonSqliteDB* db, const char* table) {
-    return sqlite_to_json(db->path, table);
+bool sqlite_cursor_failed(const SqliteJsonCursor* cursor) {
+    return cursor && cursor->failed;
+}
+
+void sqlite_cursor_close(SqliteJsonCursor* cursor) {
+    if (!cursor) return;
+    if (cursor->stmt) sqlite3_finalize(cursor->stmt);
+    json_arena_destroy(cursor->arena);
+    if (cursor->column_names) {
+        for (int i = 0; i < cursor->column_count; i++) {
+            free(cursor->column_names[i]);
+        }
+        free(cursor->column_names);
+    }
+    free(cursor);
 }
 
 bool sqlite_update(JsonSqliteDB* db, const char* table, const char* key, const char* key_value, const JsonValue* new_data) {
@@ -700,7 +1055,7 @@ bool sqlite_update(JsonSqliteDB* db, const char* table, const char* key, const c
                 bind_rc = sqlite3_bind_double(stmt, i + 1, val->data.number_value);
                 break;
             case JSON_STRING:
-                bind_rc = sqlite3_bind_text(stmt, i + 1, val->data.string_value, -1, SQLITE_TRANSIENT);
+                bind_rc = sqlite3_bind_text(stmt, i + 1, json_string_value(val), -1, SQLITE_TRANSIENT);
                 break;
             case JSON_BOOL:
                 bind_rc = sqlite3_bind_int(stmt, i + 1, val->data.bool_value ? 1 : 0);
@@ -859,11 +1214,12 @@ void sqlite_optimize(JsonSqliteDB* db) {
 
 void sqlite_close(JsonSqliteDB* db) {
     if (!db) return;
-    
+
     if (db->auto_optimize) {
         sqlite_optimize(db);
     }
-    
+
+    stmt_cache_free(db);
     sqlite3_close(db->db);
     free(db->path);
     free(db);
@@ -2,6 +2,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
+#include <pthread.h>
 
 #define STREAM_BUFFER_SIZE 8192
 #define MAX_STREAM_DEPTH 256
@@ -137,6 +138,7 @@ bool json_stream_parse_chunk(JsonStreamParser* parser, const char* chunk, size_t
         
         parser->buffer[parser->buffer_size++] = c;
         parser->buffer[parser->buffer_size] = '\0';
+        JSON_STAT_MAX(stream_buffer_high_water, parser->buffer_size);
         
         if (c == '\n') {
             parser->line++;
@@ -202,45 +204,515 @@ bool json_stream_parse_chunk(JsonStreamParser* parser, const char* chunk, size_t
     return true;
 }
 
+// ---------------------------------------------------------------------------
+// File path: a two-slot ring of 1MB buffers with readahead on a second
+// thread. Top-level values that fit inside one buffer are parsed straight
+// out of it (no copy into parser->buffer); only values straddling a buffer
+// boundary are accumulated. The chunk API above is unchanged.
+// ---------------------------------------------------------------------------
+
+#define STREAM_RING_BUFFERS 2
+#define STREAM_RING_BUFFER_SIZE (1024 * 1024)
+
+typedef struct {
+    char* data[STREAM_RING_BUFFERS];
+    size_t length[STREAM_RING_BUFFERS];
+    bool full[STREAM_RING_BUFFERS];
+    bool aborted;
+    bool read_error;
+    FILE* file;
+    pthread_mutex_t lock;
+    pthread_cond_t can_fill;
+    pthread_cond_t can_drain;
+} StreamRing;
+
+static void* stream_ring_fill(void* arg) {
+    StreamRing* ring = arg;
+    size_t slot = 0;
+
+    for (;;) {
+        pthread_mutex_lock(&ring->lock);
+        while (ring->full[slot] && !ring->aborted) {
+            pthread_cond_wait(&ring->can_fill, &ring->lock);
+        }
+        if (ring->aborted) {
+            pthread_mutex_unlock(&ring->lock);
+            return NULL;
+        }
+        pthread_mutex_unlock(&ring->lock);
+
+        size_t n = fread(ring->data[slot], 1, STREAM_RING_BUFFER_SIZE, ring->file);
+
+        pthread_mutex_lock(&ring->lock);
+        ring->length[slot] = n;
+        if (n == 0) {
+            ring->read_error = ferror(ring->file) != 0;
+        }
+        ring->full[slot] = true;
+        pthread_cond_signal(&ring->can_drain);
+        pthread_mutex_unlock(&ring->lock);
+
+        if (n == 0) return NULL;  // EOF (or error) slot delivered
+        slot = (slot + 1) % STREAM_RING_BUFFERS;
+    }
+}
+
+// Append a span to the parser's accumulation buffer (boundary-straddling
+// values only), with the same 100MB guard as chunk mode
+static bool stream_accumulate(JsonStreamParser* parser, const char* data, size_t length) {
+    if (parser->buffer_size + length + 1 > parser->buffer_capacity) {
+        size_t new_capacity = parser->buffer_capacity;
+        while (new_capacity < parser->buffer_size + length + 1) new_capacity *= 2;
+        if (new_capacity > 100 * 1024 * 1024) {
+            json_set_error(JSON_ERROR_OUT_OF_MEMORY, "Stream buffer too large (>100MB)", parser->line, parser->column);
+            return false;
+        }
+        char* fresh = realloc(parser->buffer, new_capacity);
+        if (!fresh) {
+            json_set_error(JSON_ERROR_OUT_OF_MEMORY, "Failed to expand stream buffer", parser->line, parser->column);
+            return false;
+        }
+        parser->buffer = fresh;
+        parser->buffer_capacity = new_capacity;
+    }
+    memcpy(parser->buffer + parser->buffer_size, data, length);
+    parser->buffer_size += length;
+    parser->buffer[parser->buffer_size] = '\0';
+    JSON_STAT_MAX(stream_buffer_high_water, parser->buffer_size);
+    return true;
+}
+
+// Parse one complete top-level value: from the live ring buffer when it fit
+// in a single read, from the accumulator when it straddled buffers
+static bool stream_finish_value(JsonStreamParser* parser, const char* span, size_t length) {
+    JsonError error;
+    JsonValue* value;
+
+    if (parser->buffer_size > 0) {
+        if (span && !stream_accumulate(parser, span, length)) return false;
+        value = json_parse_with_error(parser->buffer, &error);
+        parser->buffer_size = 0;
+        parser->buffer[0] = '\0';
+    } else {
+        value = json_parse_buffer(span, length);
+        error = *json_get_last_error();
+    }
+
+    if (!value) {
+        parser->error = error;
+        JsonStreamEvent event = {JSON_EVENT_ERROR, NULL, NULL};
+        stream_emit_event(parser, &event);
+        return false;
+    }
+
+    JsonStreamEvent event = {JSON_EVENT_VALUE, value, NULL};
+    bool keep_going = stream_emit_event(parser, &event);
+    json_free(value);
+    parser->values_parsed++;
+    return keep_going;
+}
+
 bool json_stream_parse_file(JsonStreamParser* parser, const char* filename) {
     if (!parser || !filename) {
         json_set_error(JSON_ERROR_NULL_POINTER, "Parser or filename is NULL", 0, 0);
         return false;
     }
-    
+
     FILE* file = fopen(filename, "rb");
     if (!file) {
         json_set_error(JSON_ERROR_FILE_NOT_FOUND, filename, 0, 0);
         return false;
     }
-    
-    char chunk[STREAM_BUFFER_SIZE];
-    size_t bytes_read;
+
+    StreamRing ring = {0};
+    ring.file = file;
+    for (size_t i = 0; i < STREAM_RING_BUFFERS; i++) {
+        ring.data[i] = malloc(STREAM_RING_BUFFER_SIZE);
+        if (!ring.data[i]) {
+            for (size_t j = 0; j < i; j++) free(ring.data[j]);
+            fclose(file);
+            json_set_error(JSON_ERROR_OUT_OF_MEMORY, "Failed to allocate stream ring", 0, 0);
+            return false;
+        }
+    }
+    pthread_mutex_init(&ring.lock, NULL);
+    pthread_cond_init(&ring.can_fill, NULL);
+    pthread_cond_init(&ring.can_drain, NULL);
+
+    pthread_t reader;
+    if (pthread_create(&reader, NULL, stream_ring_fill, &ring) != 0) {
+        for (size_t i = 0; i < STREAM_RING_BUFFERS; i++) free(ring.data[i]);
+        fclose(file);
+        json_set_error(JSON_ERROR_OUT_OF_MEMORY, "Failed to start readahead thread", 0, 0);
+        return false;
+    }
+
     bool success = true;
-    
-    while ((bytes_read = fread(chunk, 1, STREAM_BUFFER_SIZE, file)) > 0) {
-        if (!json_stream_parse_chunk(parser, chunk, bytes_read)) {
-            success = false;
+    bool done = false;
+    size_t slot = 0;
+    // Offset of the in-progress top-level value in the current buffer, or
+    // SIZE_MAX when between values. A non-empty accumulator means the value
+    // began in an earlier buffer.
+    size_t value_start = (size_t)-1;
+    bool value_is_container = false;
+
+    while (!done) {
+        pthread_mutex_lock(&ring.lock);
+        while (!ring.full[slot]) {
+            pthread_cond_wait(&ring.can_drain, &ring.lock);
+        }
+        size_t length = ring.length[slot];
+        bool read_error = ring.read_error;
+        pthread_mutex_unlock(&ring.lock);
+
+        if (length == 0) {
+            // EOF: finish an in-flight value, if any
+            if (read_error) {
+                json_set_error(JSON_ERROR_FILE_READ_ERROR, filename, parser->line, parser->column);
+                success = false;
+            } else if (parser->in_string) {
+                json_set_error(JSON_ERROR_UNTERMINATED_STRING, "Unterminated string in stream", parser->line, parser->column);
+                parser->error = g_json_last_error;
+                success = false;
+            } else if (parser->buffer_size > 0) {
+                success = stream_finish_value(parser, NULL, 0);
+            }
+            done = true;
             break;
         }
+
+        const char* data = ring.data[slot];
+        if (parser->buffer_size > 0 || parser->in_string) {
+            // Value continues from the previous buffer
+            value_start = 0;
+        } else {
+            value_start = (size_t)-1;
+        }
+
+        for (size_t i = 0; i < length && success; i++) {
+            char c = data[i];
+
+            if (c == '\n') {
+                parser->line++;
+                parser->column = 0;
+            } else {
+                parser->column++;
+            }
+
+            if (parser->in_string) {
+                if (parser->escaped) {
+                    parser->escaped = false;
+                } else if (c == '\\') {
+                    parser->escaped = true;
+                } else if (c == '"') {
+                    parser->in_string = false;
+                    if (parser->depth == 0 && !value_is_container) {
+                        // Top-level string value completes here
+                        success = stream_finish_value(parser, data + value_start, i - value_start + 1);
+                        value_start = (size_t)-1;
+                    }
+                }
+                continue;
+            }
+
+            switch (c) {
+                case '"':
+                    parser->in_string = true;
+                    if (parser->depth == 0 && value_start == (size_t)-1) {
+                        value_start = i;
+                        value_is_container = false;
+                    }
+                    break;
+                case '{':
+                case '[':
+                    if (parser->depth >= MAX_STREAM_DEPTH) {
+                        json_set_error(JSON_ERROR_STACK_OVERFLOW, "Stream depth too deep", parser->line, parser->column);
+                        parser->error = g_json_last_error;
+                        success = false;
+                        break;
+                    }
+                    if (parser->depth == 0) {
+                        value_start = i;
+                        value_is_container = true;
+                        if (c == '{') {
+                            parser->objects_parsed++;
+                        } else {
+                            parser->arrays_parsed++;
+                        }
+                        JsonStreamEvent event = {
+                            c == '{' ? JSON_EVENT_OBJECT_START : JSON_EVENT_ARRAY_START,
+                            NULL, NULL
+                        };
+                        if (!stream_emit_event(parser, &event)) {
+                            success = false;
+                            break;
+                        }
+                    }
+                    parser->depth++;
+                    break;
+                case '}':
+                case ']':
+                    if (parser->depth == 0) {
+                        // Stray closer with no open container
+                        json_set_error(JSON_ERROR_UNEXPECTED_TOKEN, "Unexpected token", parser->line, parser->column);
+                        parser->error = g_json_last_error;
+                        JsonStreamEvent event = {JSON_EVENT_ERROR, NULL, NULL};
+                        stream_emit_event(parser, &event);
+                        success = false;
+                        break;
+                    }
+                    parser->depth--;
+                    if (parser->depth == 0) {
+                        success = stream_finish_value(parser, data + value_start, i - value_start + 1);
+                        value_start = (size_t)-1;
+                        if (success) {
+                            JsonStreamEvent event = {
+                                c == '}' ? JSON_EVENT_OBJECT_END : JSON_EVENT_ARRAY_END,
+                                NULL, NULL
+                            };
+                            if (!stream_emit_event(parser, &event)) success = false;
+                        }
+                    }
+                    break;
+                default:
+                    if (parser->depth == 0) {
+                        if (value_start == (size_t)-1) {
+                            if (!isspace((unsigned char)c) && c != ',') {
+                                value_start = i;
+                                value_is_container = false;
+                            }
+                        } else if (!value_is_container && (isspace((unsigned char)c) || c == ',')) {
+                            // Top-level scalar ends at whitespace or comma
+                            success = stream_finish_value(parser, data + value_start, i - value_start);
+                            value_start = (size_t)-1;
+                        }
+                    }
+                    break;
+            }
+        }
+
+        // Carry a partial value across the buffer boundary
+        if (success && value_start != (size_t)-1) {
+            if (!stream_accumulate(parser, data + value_start, length - value_start)) {
+                success = false;
+            }
+        }
+
+        pthread_mutex_lock(&ring.lock);
+        ring.full[slot] = false;
+        if (!success) ring.aborted = true;
+        pthread_cond_signal(&ring.can_fill);
+        pthread_mutex_unlock(&ring.lock);
+
+        if (!success) break;
+        slot = (slot + 1) % STREAM_RING_BUFFERS;
     }
-    
+
+    pthread_mutex_lock(&ring.lock);
+    ring.aborted = true;
+    pthread_cond_broadcast(&ring.can_fill);
+    pthread_mutex_unlock(&ring.lock);
+    pthread_join(reader, NULL);
+
+    pthread_mutex_destroy(&ring.lock);
+    pthread_cond_destroy(&ring.can_fill);
+    pthread_cond_destroy(&ring.can_drain);
+    for (size_t i = 0; i < STREAM_RING_BUFFERS; i++) free(ring.data[i]);
     fclose(file);
-    
-    if (success && parser->buffer_size > 0) {
-        success = stream_try_parse_complete_value(parser);
-    }
-    
+
     if (success) {
         JsonStreamEvent event = {JSON_EVENT_EOF, NULL, NULL};
         stream_emit_event(parser, &event);
     }
-    
+
     return success;
 }
 
+bool json_stream_parse_file_r(JsonStreamParser* parser, const char* filename, JsonError* error) {
+    bool ok = json_stream_parse_file(parser, filename);
+    if (error) *error = *json_get_last_error();
+    return ok;
+}
+
 void json_stream_parser_free(JsonStreamParser* parser) {
     if (!parser) return;
     free(parser->buffer);
     free(parser);
 }
+
+// Pull-style reader: yields one fully-built JsonValue per element of the
+// outermost array (or per newline-delimited record) while holding only
+// the current record in memory. Records are parsed into an arena that is
+// recycled between calls, so each returned value is valid until the next
+// json_stream_next or json_stream_reader_close.
+struct JsonStreamReader {
+    FILE* file;
+    JsonArena* arena;
+    char chunk[STREAM_BUFFER_SIZE];
+    size_t chunk_size;
+    size_t chunk_pos;
+    char* record;
+    size_t record_size;
+    size_t record_capacity;
+    int depth;
+    bool in_string;
+    bool escaped;
+    bool array_mode;
+    bool started;
+    bool finished;
+    bool failed;
+};
+
+JsonStreamReader* json_stream_reader_open(const char* filename) {
+    if (!filename) {
+        json_set_error(JSON_ERROR_NULL_POINTER, "Filename is NULL", 0, 0);
+        return NULL;
+    }
+
+    FILE* file = fopen(filename, "rb");
+    if (!file) {
+        json_set_error(JSON_ERROR_FILE_NOT_FOUND, filename, 0, 0);
+        return NULL;
+    }
+
+    JsonStreamReader* reader = calloc(1, sizeof(JsonStreamReader));
+    if (!reader) {
+        fclose(file);
+        json_set_error(JSON_ERROR_OUT_OF_MEMORY, "Failed to allocate stream reader", 0, 0);
+        return NULL;
+    }
+
+    reader->file = file;
+    reader->arena = json_arena_create(0);
+    reader->record_capacity = STREAM_BUFFER_SIZE;
+    reader->record = malloc(reader->record_capacity);
+    if (!reader->arena || !reader->record) {
+        json_stream_reader_close(reader);
+        json_set_error(JSON_ERROR_OUT_OF_MEMORY, "Failed to allocate stream reader", 0, 0);
+        return NULL;
+    }
+
+    return reader;
+}
+
+static bool reader_append(JsonStreamReader* reader, char c) {
+    if (reader->record_size + 2 > reader->record_capacity) {
+        size_t new_capacity = reader->record_capacity * 2;
+        char* fresh = realloc(reader->record, new_capacity);
+        if (!fresh) {
+            json_set_error(JSON_ERROR_OUT_OF_MEMORY, "Failed to expand record buffer", 0, 0);
+            reader->failed = true;
+            return false;
+        }
+        reader->record = fresh;
+        reader->record_capacity = new_capacity;
+    }
+    reader->record[reader->record_size++] = c;
+    return true;
+}
+
+static JsonValue* reader_finish_record(JsonStreamReader* reader) {
+    reader->record[reader->record_size] = '\0';
+    reader->record_size = 0;
+
+    // Recycle the arena: the previously returned value dies here
+    json_arena_reset(reader->arena);
+    JsonValue* value = json_parse_arena(reader->record, reader->arena);
+    if (!value) {
+        reader->failed = true;
+    }
+    return value;
+}
+
+JsonValue* json_stream_next(JsonStreamReader* reader) {
+    if (!reader) {
+        json_set_error(JSON_ERROR_NULL_POINTER, "Reader is NULL", 0, 0);
+        return NULL;
+    }
+    if (reader->failed || reader->finished) return NULL;
+
+    for (;;) {
+        if (reader->chunk_pos >= reader->chunk_size) {
+            reader->chunk_size = fread(reader->chunk, 1, STREAM_BUFFER_SIZE, reader->file);
+            reader->chunk_pos = 0;
+            if (reader->chunk_size == 0) {
+                reader->finished = true;
+                if (reader->array_mode && reader->started) {
+                    json_set_error(JSON_ERROR_UNEXPECTED_EOF, "Unterminated array in stream", 0, 0);
+                    reader->failed = true;
+                    return NULL;
+                }
+                if (reader->record_size > 0) {
+                    return reader_finish_record(reader);
+                }
+                return NULL;
+            }
+        }
+
+        char c = reader->chunk[reader->chunk_pos++];
+
+        if (!reader->started) {
+            if (isspace((unsigned char)c)) continue;
+            reader->started = true;
+            if (c == '[') {
+                reader->array_mode = true;
+                continue;
+            }
+            // Fall through: newline-delimited records
+        }
+
+        if (reader->in_string) {
+            if (!reader_append(reader, c)) return NULL;
+            if (reader->escaped) {
+                reader->escaped = false;
+            } else if (c == '\\') {
+                reader->escaped = true;
+            } else if (c == '"') {
+                reader->in_string = false;
+            }
+            continue;
+        }
+
+        if (c == '"') {
+            reader->in_string = true;
+            if (!reader_append(reader, c)) return NULL;
+        } else if (c == '{' || c == '[') {
+            reader->depth++;
+            if (!reader_append(reader, c)) return NULL;
+        } else if (c == '}' || (c == ']' && reader->depth > 0)) {
+            reader->depth--;
+            if (!reader_append(reader, c)) return NULL;
+        } else if (c == ']' && reader->array_mode) {
+            // Closing bracket of the outer array
+            reader->finished = true;
+            if (reader->record_size > 0) {
+                return reader_finish_record(reader);
+            }
+            return NULL;
+        } else if (c == ',' && reader->depth == 0 && reader->array_mode) {
+            if (reader->record_size > 0) {
+                return reader_finish_record(reader);
+            }
+        } else if (c == '\n' && reader->depth == 0 && !reader->array_mode) {
+            if (reader->record_size > 0) {
+                return reader_finish_record(reader);
+            }
+        } else if (isspace((unsigned char)c) && reader->record_size == 0) {
+            continue;
+        } else {
+            if (!reader_append(reader, c)) return NULL;
+        }
+    }
+}
+
+bool json_stream_reader_failed(const JsonStreamReader* reader) {
+    return reader && reader->failed;
+}
+
+void json_stream_reader_close(JsonStreamReader* reader) {
+    if (!reader) return;
+    if (reader->file) fclose(reader->file);
+    json_arena_destroy(reader->arena);
+    free(reader->record);
+    free(reader);
+}
@@ -4,53 +4,109 @@
 #include <stdio.h>
 #include <math.h>
 
+#define STRINGIFY_BLOCK_SIZE (64 * 1024)
+
+// Rope of fixed-size blocks: appends never move existing bytes, and the
+// result is joined with a single copy at the end. An optional sink
+// callback lets full blocks be flushed out instead of accumulated.
+typedef struct WriterBlock {
+    struct WriterBlock* next;
+    size_t used;
+    size_t size;
+    char data[];
+} WriterBlock;
+
 typedef struct {
-    char* buffer;
-    size_t length;
-    size_t capacity;
+    WriterBlock* head;
+    WriterBlock* tail;
+    size_t total;
+    size_t block_size;
     int indent_level;
+    int indent_width;
     bool pretty;
+    bool failed;
+    JsonWriteSink sink;
+    void* sink_data;
 } StringifyContext;
 
-static void ensure_capacity(StringifyContext* ctx, size_t needed) {
-    if (ctx->length + needed >= ctx->capacity) {
-        while (ctx->length + needed >= ctx->capacity) {
-            ctx->capacity *= 2;
+static WriterBlock* writer_new_block(size_t size) {
+    WriterBlock* block = malloc(sizeof(WriterBlock) + size);
+    if (!block) return NULL;
+    block->next = NULL;
+    block->used = 0;
+    block->size = size;
+    return block;
+}
+
+static bool writer_flush_tail(StringifyContext* ctx) {
+    // With a sink the full block is written out and reused; without one
+    // a fresh block is chained onto the rope
+    if (ctx->sink) {
+        if (!ctx->sink(ctx->tail->data, ctx->tail->used, ctx->sink_data)) {
+            ctx->failed = true;
+            return false;
         }
-        char* new_buffer = realloc(ctx->buffer, ctx->capacity);
-        if (!new_buffer) {
-            json_set_error(JSON_ERROR_OUT_OF_MEMORY, "Failed to expand stringify buffer", 0, 0);
-            return;
+        ctx->tail->used = 0;
+        return true;
+    }
+
+    WriterBlock* fresh = writer_new_block(ctx->block_size);
+    if (!fresh) {
+        json_set_error(JSON_ERROR_OUT_OF_MEMORY, "Failed to allocate stringify block", 0, 0);
+        ctx->failed = true;
+        return false;
+    }
+    ctx->tail->next = fresh;
+    ctx->tail = fresh;
+    JSON_STAT_ADD(stringify_grow_blocks, 1);
+    return true;
+}
+
+static void writer_append(StringifyContext* ctx, const char* data, size_t length) {
+    if (ctx->failed) return;
+
+    while (length > 0) {
+        size_t room = ctx->tail->size - ctx->tail->used;
+        if (room == 0) {
+            if (!writer_flush_tail(ctx)) return;
+            room = ctx->tail->size;
         }
-        ctx->buffer = new_buffer;
+
+        size_t take = length < room ? length : room;
+        memcpy(ctx->tail->data + ctx->tail->used, data, take);
+        ctx->tail->used += take;
+        ctx->total += take;
+        data += take;
+        length -= take;
     }
 }
 
 static void append_string(StringifyContext* ctx, const char* str) {
-    size_t len = strlen(str);
-    ensure_capacity(ctx, len + 1);
-    memcpy(ctx->buffer + ctx->length, str, len);
-    ctx->length += len;
-    ctx->buffer[ctx->length] = '\0';
+    writer_append(ctx, str, strlen(str));
 }
 
 static void append_char(StringifyContext* ctx, char c) {
-    ensure_capacity(ctx, 2);
-    ctx->buffer[ctx->length++] = c;
-    ctx->buffer[ctx->length] = '\0';
+    if (ctx->failed) return;
+
+    if (ctx->tail->used < ctx->tail->size) {
+        ctx->tail->data[ctx->tail->used++] = c;
+        ctx->total++;
+        return;
+    }
+    writer_append(ctx, &c, 1);
 }
 
 static void append_indent(StringifyContext* ctx) {
     if (!ctx->pretty) return;
     append_char(ctx, '\n');
-    for (int i = 0; i < ctx->indent_level * 2; i++) {
+    for (int i = 0; i < ctx->indent_level * ctx->indent_width; i++) {
         append_char(ctx, ' ');
     }
 }
 
 static void escape_and_append_string(StringifyContext* ctx, const char* str) {
     append_char(ctx, '"');
-    
+
     for (const char* p = str; *p; p++) {
         switch (*p) {
             case '"':
@@ -85,7 +141,7 @@ static void escape_and_append_string(StringifyContext* ctx, const char* str) {
                 break;
         }
     }
-    
+
     append_char(ctx, '"');
 }
 
@@ -93,68 +149,68 @@ static void stringify_value(StringifyContext* ctx, const JsonValue* value);
 
 static void stringify_array(StringifyContext* ctx, const JsonValue* value) {
     JsonArray* arr = value->data.array_value;
-    
+
     append_char(ctx, '[');
-    
+
     if (arr->count > 0) {
         ctx->indent_level++;
-        
+
         for (size_t i = 0; i < arr->count; i++) {
             if (ctx->pretty) {
                 append_indent(ctx);
             }
-            
+
             stringify_value(ctx, arr->values[i]);
-            
+
             if (i < arr->count - 1) {
                 append_char(ctx, ',');
             }
         }
-        
+
         ctx->indent_level--;
-        
+
         if (ctx->pretty) {
             append_indent(ctx);
         }
     }
-    
+
     append_char(ctx, ']');
 }
 
 static void stringify_object(StringifyContext* ctx, const JsonValue* value) {
     JsonObject* obj = value->data.object_value;
-    
+
     append_char(ctx, '{');
-    
+
     if (obj->count > 0) {
         ctx->indent_level++;
-        
+
         for (size_t i = 0; i < obj->count; i++) {
             if (ctx->pretty) {
                 append_indent(ctx);
             }
-            
+
             escape_and_append_string(ctx, obj->pairs[i].key);
             append_char(ctx, ':');
-            
+
             if (ctx->pretty) {
                 append_char(ctx, ' ');
             }
-            
+
             stringify_value(ctx, obj->pairs[i].value);
-            
+
             if (i < obj->count - 1) {
                 append_char(ctx, ',');
             }
         }
-        
+
         ctx->indent_level--;
-        
+
         if (ctx->pretty) {
             append_indent(ctx);
         }
     }
-    
+
     append_char(ctx, '}');
 }
 
@@ -163,71 +219,186 @@ static void stringify_value(StringifyContext* ctx, const JsonValue* value) {
         append_string(ctx, "null");
         return;
     }
-    
+
     switch (value->type) {
         case JSON_NULL:
             append_string(ctx, "null");
             break;
-            
+
         case JSON_BOOL:
             append_string(ctx, value->data.bool_value ? "true" : "false");
             break;
-            
+
         case JSON_NUMBER: {
-            char num_buffer[64];
-            double num = value->data.number_value;
-            
-            if (isnan(num) || isinf(num)) {
-                append_string(ctx, "null");
-            } else if (num == (long long)num) {
-                snprintf(num_buffer, sizeof(num_buffer), "%lld", (long long)num);
-            } else {
-                snprintf(num_buffer, sizeof(num_buffer), "%.17g", num);
-            }
-            append_string(ctx, num_buffer);
+            char num_buffer[JSON_NUMBER_BUFFER_SIZE];
+            size_t len = json_number_format(value->data.number_value, num_buffer);
+            writer_append(ctx, num_buffer, len);
             break;
         }
-            
+
         case JSON_STRING:
-            escape_and_append_string(ctx, value->data.string_value);
+            escape_and_append_string(ctx, json_string_value(value));
             break;
-            
+
         case JSON_ARRAY:
             stringify_array(ctx, value);
             break;
-            
+
         case JSON_OBJECT:
             stringify_object(ctx, value);
             break;
     }
 }
 
-char* json_stringify(const JsonValue* value, bool pretty) {
-    if (!value) {
-        json_set_error(JSON_ERROR_NULL_POINTER, "Cannot stringify NULL value", 0, 0);
+static void writer_free_blocks(StringifyContext* ctx) {
+    WriterBlock* block = ctx->head;
+    while (block) {
+        WriterBlock* next = block->next;
+        free(block);
+        block = next;
+    }
+    ctx->head = ctx->tail = NULL;
+}
+
+static char* writer_join(StringifyContext* ctx) {
+    char* result = malloc(ctx->total + 1);
+    if (!result) {
+        json_set_error(JSON_ERROR_OUT_OF_MEMORY, "Failed to allocate stringify result", 0, 0);
         return NULL;
     }
-    
+
+    size_t offset = 0;
+    for (WriterBlock* block = ctx->head; block; block = block->next) {
+        memcpy(result + offset, block->data, block->used);
+        offset += block->used;
+    }
+    result[offset] = '\0';
+    return result;
+}
+
+// Estimated output size for a pretty print of the value; reuses the
+// shape of the json_memory_usage traversal. Upper-ish bound used to
+// pre-size the writer so typical documents serialize into one block
+static size_t stringify_size_hint(const JsonValue* value, int depth) {
+    if (!value) return 4;
+
+    switch (value->type) {
+        case JSON_NULL:
+            return 4;
+        case JSON_BOOL:
+            return 5;
+        case JSON_NUMBER:
+            return 24;
+        case JSON_STRING:
+            // Worst common case is a handful of escaped characters
+            return strlen(json_string_value(value)) + 8;
+        case JSON_ARRAY: {
+            JsonArray* arr = value->data.array_value;
+            size_t per_element = 2 + (size_t)(depth + 1) * 2;
+            size_t total = 2 + (size_t)(depth + 1) * 2;
+            for (size_t i = 0; i < arr->count; i++) {
+                total += per_element + stringify_size_hint(arr->values[i], depth + 1);
+            }
+            return total;
+        }
+        case JSON_OBJECT: {
+            JsonObject* obj = value->data.object_value;
+            size_t per_pair = 6 + (size_t)(depth + 1) * 2;
+            size_t total = 2 + (size_t)(depth + 1) * 2;
+            for (size_t i = 0; i < obj->count; i++) {
+                total += per_pair + strlen(obj->pairs[i].key)
+                       + stringify_size_hint(obj->pairs[i].value, depth + 1);
+            }
+            return total;
+        }
+    }
+    return 4;
+}
+
+size_t json_stringify_size_hint(const JsonValue* value) {
+    return stringify_size_hint(value, 0) + 2;
+}
+
+// Internal entry shared by the public stringify variants: runs the
+// traversal against a configured writer, with an optional sink that
+// receives flushed blocks instead of growing the rope
+bool json_stringify_to_sink(const JsonValue* value, const JsonWriteConfig* config,
+                            JsonWriteSink sink, void* sink_data, char** out) {
+    if (!value) {
+        json_set_error(JSON_ERROR_NULL_POINTER, "Value is NULL", 0, 0);
+        return false;
+    }
+
+    JsonWriteConfig defaults = {false, 2, 0, 0};
+    if (!config) config = &defaults;
+
     StringifyContext ctx = {
-        .buffer = malloc(1024),
-        .length = 0,
-        .capacity = 1024,
+        .head = NULL,
+        .tail = NULL,
+        .total = 0,
+        .block_size = config->block_size ? config->block_size : STRINGIFY_BLOCK_SIZE,
         .indent_level = 0,
-        .pretty = pretty
+        .indent_width = config->indent_width > 0 ? config->indent_width : 2,
+        .pretty = config->pretty,
+        .failed = false,
+        .sink = sink,
+        .sink_data = sink_data
     };
-    
-    if (!ctx.buffer) {
-        json_set_error(JSON_ERROR_OUT_OF_MEMORY, "Failed to allocate stringify buffer", 0, 0);
-        return NULL;
+
+    size_t first_size = ctx.block_size;
+    if (!sink && config->size_hint > first_size) {
+        first_size = config->size_hint;
     }
-    
-    ctx.buffer[0] = '\0';
-    
+
+    ctx.head = ctx.tail = writer_new_block(first_size);
+    if (!ctx.head) {
+        json_set_error(JSON_ERROR_OUT_OF_MEMORY, "Failed to allocate stringify block", 0, 0);
+        return false;
+    }
+
     stringify_value(&ctx, value);
-    
-    if (pretty && (value->type == JSON_OBJECT || value->type == JSON_ARRAY)) {
+
+    if (ctx.pretty && (value->type == JSON_OBJECT || value->type == JSON_ARRAY)) {
         append_char(&ctx, '\n');
     }
-    
-    return ctx.buffer;
+
+    if (!ctx.failed && sink && ctx.tail->used > 0) {
+        if (!sink(ctx.tail->data, ctx.tail->used, sink_data)) {
+            ctx.failed = true;
+        }
+    }
+
+    char* result = NULL;
+    if (!ctx.failed && out) {
+        result = writer_join(&ctx);
+        if (!result) ctx.failed = true;
+    }
+
+    writer_free_blocks(&ctx);
+    if (out) *out = result;
+    return !ctx.failed;
+}
+
+char* json_stringify_ex(const JsonValue* value, const JsonWriteConfig* config) {
+    if (!value) {
+        json_set_error(JSON_ERROR_NULL_POINTER, "Cannot stringify NULL value", 0, 0);
+        return NULL;
+    }
+
+    char* result = NULL;
+    if (!json_stringify_to_sink(value, config, NULL, NULL, &result)) {
+        return NULL;
+    }
+    return result;
+}
+
+char* json_stringify(const JsonValue* value, bool pretty) {
+    JsonWriteConfig config = {pretty, 2, 0, 0};
+    return json_stringify_ex(value, &config);
+}
+
+char* json_stringify_r(const JsonValue* value, bool pretty, JsonError* error) {
+    char* result = json_stringify(value, pretty);
+    if (error) *error = *json_get_last_error();
+    return result;
 }
@@ -553,10 +553,226 @@ JsonValue* csv_to_json(const char* csv) {
         free(headers[i]);
     }
     free(headers);
-    
+
     return array;
 }
 
+JsonValue* csv_to_json_r(const char* csv, JsonError* error) {
+    JsonValue* result = csv_to_json(csv);
+    if (error) *error = *json_get_last_error();
+    return result;
+}
+
+// Streaming CSV reader: the file is processed through a fixed chunk
+// buffer one record at a time, and each row object is built in a single
+// arena that is recycled between rows, so memory stays constant no
+// matter how large the file is.
+
+#define CSV_STREAM_CHUNK 8192
+
+typedef struct {
+    char* data;
+    size_t length;
+    size_t capacity;
+} CsvRecord;
+
+static bool csv_record_push(CsvRecord* rec, char c) {
+    if (rec->length + 1 >= rec->capacity) {
+        size_t new_capacity = rec->capacity ? rec->capacity * 2 : 256;
+        char* fresh = realloc(rec->data, new_capacity);
+        if (!fresh) {
+            json_set_error(JSON_ERROR_OUT_OF_MEMORY, "Failed to grow CSV record buffer", 0, 0);
+            return false;
+        }
+        rec->data = fresh;
+        rec->capacity = new_capacity;
+    }
+    rec->data[rec->length++] = c;
+    return true;
+}
+
+// Scan one field from *cursor; fields follow the same quoting rules as
+// csv_to_json ("" stays as written). Returns the raw span.
+static void csv_scan_field(const char** cursor, const char** start, size_t* len) {
+    const char* ptr = *cursor;
+    while (*ptr && isspace((unsigned char)*ptr)) ptr++;
+
+    bool in_quotes = false;
+    if (*ptr == '"') {
+        in_quotes = true;
+        ptr++;
+        *start = ptr;
+        while (*ptr && !(*ptr == '"' && *(ptr + 1) != '"')) {
+            if (*ptr == '"' && *(ptr + 1) == '"') ptr += 2;
+            else ptr++;
+        }
+    } else {
+        *start = ptr;
+        while (*ptr && *ptr != ',') ptr++;
+    }
+
+    *len = (size_t)(ptr - *start);
+    if (in_quotes && *ptr == '"') ptr++;
+    if (*ptr == ',') ptr++;
+    *cursor = ptr;
+}
+
+static void csv_free_headers(char** headers, size_t count) {
+    for (size_t i = 0; i < count; i++) free(headers[i]);
+    free(headers);
+}
+
+static char** csv_parse_headers(const char* record, size_t* out_count) {
+    size_t count = 0;
+    size_t capacity = 16;
+    char** headers = malloc(capacity * sizeof(char*));
+    if (!headers) {
+        json_set_error(JSON_ERROR_OUT_OF_MEMORY, "Failed to allocate headers array", 0, 0);
+        return NULL;
+    }
+
+    const char* cursor = record;
+    while (*cursor) {
+        const char* start;
+        size_t len;
+        csv_scan_field(&cursor, &start, &len);
+
+        char* header = malloc(len + 1);
+        if (!header) {
+            csv_free_headers(headers, count);
+            json_set_error(JSON_ERROR_OUT_OF_MEMORY, "Failed to allocate header", 0, 0);
+            return NULL;
+        }
+        memcpy(header, start, len);
+        header[len] = '\0';
+
+        if (count >= capacity) {
+            capacity *= 2;
+            char** fresh = realloc(headers, capacity * sizeof(char*));
+            if (!fresh) {
+                free(header);
+                csv_free_headers(headers, count);
+                json_set_error(JSON_ERROR_OUT_OF_MEMORY, "Failed to grow headers array", 0, 0);
+                return NULL;
+            }
+            headers = fresh;
+        }
+        headers[count++] = header;
+    }
+
+    *out_count = count;
+    return headers;
+}
+
+// Build one arena-backed row object from a record line
+static JsonValue* csv_build_row(const char* record, char** headers, size_t header_count) {
+    JsonValue* row = json_create_object();
+    if (!row) return NULL;
+
+    const char* cursor = record;
+    for (size_t i = 0; i < header_count && *cursor; i++) {
+        const char* start;
+        size_t len;
+        csv_scan_field(&cursor, &start, &len);
+
+        char* value_str = malloc(len + 1);
+        if (!value_str) return NULL;
+        memcpy(value_str, start, len);
+        value_str[len] = '\0';
+
+        JsonValue* value = json_create_string(value_str);
+        free(value_str);
+        if (!value || !json_object_set(row, headers[i], value)) return NULL;
+    }
+    return row;
+}
+
+bool csv_file_to_json_stream(const char* filename, JsonCsvRowCallback callback, void* user_data) {
+    if (!filename || !callback) {
+        json_set_error(JSON_ERROR_NULL_POINTER, "Filename or callback is NULL", 0, 0);
+        return false;
+    }
+
+    FILE* file = fopen(filename, "rb");
+    if (!file) {
+        json_set_error(JSON_ERROR_FILE_NOT_FOUND, filename, 0, 0);
+        return false;
+    }
+
+    JsonArena* arena = json_arena_create(0);
+    if (!arena) {
+        fclose(file);
+        return false;
+    }
+
+    CsvRecord record = {0};
+    char** headers = NULL;
+    size_t header_count = 0;
+    size_t row_index = 0;
+    bool in_quotes = false;
+    bool ok = true;
+    bool stopped = false;
+
+    char chunk[CSV_STREAM_CHUNK];
+    size_t bytes_read;
+
+    while (ok && !stopped && (bytes_read = fread(chunk, 1, sizeof(chunk), file)) > 0) {
+        for (size_t i = 0; i < bytes_read && ok && !stopped; i++) {
+            char c = chunk[i];
+            if (c == '"') in_quotes = !in_quotes;
+
+            if (c == '\n' && !in_quotes) {
+                if (record.length == 0) continue;
+                record.data[record.length] = '\0';
+
+                if (!headers) {
+                    headers = csv_parse_headers(record.data, &header_count);
+                    if (!headers) ok = false;
+                } else {
+                    json_arena_reset(arena);
+                    JsonArena* previous = json_arena_activate(arena);
+                    JsonValue* row = csv_build_row(record.data, headers, header_count);
+                    json_arena_activate(previous);
+
+                    if (!row) ok = false;
+                    else if (!callback(row, row_index++, user_data)) stopped = true;
+                }
+                record.length = 0;
+            } else if (c != '\r' || in_quotes) {
+                ok = csv_record_push(&record, c);
+            }
+        }
+    }
+
+    // Final record without a trailing newline
+    if (ok && !stopped && record.length > 0) {
+        record.data[record.length] = '\0';
+        if (!headers) {
+            headers = csv_parse_headers(record.data, &header_count);
+            if (!headers) ok = false;
+        } else {
+            json_arena_reset(arena);
+            JsonArena* previous = json_arena_activate(arena);
+            JsonValue* row = csv_build_row(record.data, headers, header_count);
+            json_arena_activate(previous);
+
+            if (!row) ok = false;
+            else callback(row, row_index++, user_data);
+        }
+    }
+
+    if (ok && !headers) {
+        json_set_error(JSON_ERROR_CONVERSION_FAILED, "CSV input is empty", 0, 0);
+        ok = false;
+    }
+
+    csv_free_headers(headers, header_count);
+    free(record.data);
+    json_arena_destroy(arena);
+    fclose(file);
+    return ok;
+}
+
 JsonValue* ini_to_json(const char* ini) {
     if (!ini) {
         json_set_error(JSON_ERROR_NULL_POINTER, "INI input is NULL", 0, 0);
@@ -66,120 +66,521 @@ static void register_copy(CopyContext* ctx, const JsonValue* original, JsonValue
     ctx->count++;
 }
 
-static JsonValue* json_deep_copy_internal(const JsonValue* value, CopyContext* ctx) {
-    if (!value) return NULL;
-
-    // Check for circular reference
-    JsonValue* existing = find_copy(ctx, value);
-    if (existing) return existing;
-
-    JsonValue* copy = NULL;
+#define TRAVERSAL_STACK_INITIAL 64
 
+static JsonValue* copy_scalar(const JsonValue* value) {
     switch (value->type) {
         case JSON_NULL:
-            copy = json_create_null();
-            break;
+            return json_create_null();
         case JSON_BOOL:
-            copy = json_create_bool(value->data.bool_value);
-            break;
+            return json_create_bool(value->data.bool_value);
         case JSON_NUMBER:
-            copy = json_create_number(value->data.number_value);
-            break;
-        case JSON_STRING: {
-            size_t len = strlen(value->data.string_value);
-            copy = json_create_string(value->data.string_value);
-            break;
-        }
-        case JSON_ARRAY: {
-            copy = json_create_array();
-            register_copy(ctx, value, copy);
-
-            JsonArray* arr = value->data.array_value;
-            for (size_t i = 0; i < arr->count; i++) {
-                JsonValue* item_copy = json_deep_copy_internal(arr->values[i], ctx);
-                json_array_append(copy, item_copy);
-            }
-            break;
-        }
-        case JSON_OBJECT: {
-            copy = json_create_object();
-            register_copy(ctx, value, copy);
-
-            JsonObject* obj = value->data.object_value;
-            for (size_t i = 0; i < obj->count; i++) {
-                JsonValue* val_copy = json_deep_copy_internal(obj->pairs[i].value, ctx);
-                json_object_set(copy, obj->pairs[i].key, val_copy);
-            }
-            break;
-        }
-    }
-
-    if (copy && value->type != JSON_ARRAY && value->type != JSON_OBJECT) {
-        register_copy(ctx, value, copy);
+            return json_create_number(value->data.number_value);
+        case JSON_STRING:
+            return json_create_string(json_string_value(value));
+        default:
+            return NULL;
     }
-
-    return copy;
 }
 
+typedef struct {
+    const JsonValue* src;
+    JsonValue* dst;
+    size_t index;
+} CopyFrame;
+
+// Iterative: one heap frame per open container, so copy depth is bounded
+// by memory rather than the C stack. Circular references resolve to the
+// already-registered copy, as before.
 JsonValue* json_deep_copy(const JsonValue* value) {
     if (!value) {
         json_set_error(JSON_ERROR_NULL_POINTER, "Value to copy is NULL", 0, 0);
         return NULL;
     }
-    
+
     CopyContext* ctx = create_copy_context();
     if (!ctx) {
         json_set_error(JSON_ERROR_OUT_OF_MEMORY, "Failed to create copy context", 0, 0);
         return NULL;
     }
-    
-    JsonValue* copy = json_deep_copy_internal(value, ctx);
+
+    JsonValue* root;
+    CopyFrame* frames = NULL;
+    size_t depth = 0;
+    size_t capacity = 0;
+
+    if (value->type != JSON_ARRAY && value->type != JSON_OBJECT) {
+        root = copy_scalar(value);
+        free_copy_context(ctx);
+        if (!root) {
+            json_set_error(JSON_ERROR_OUT_OF_MEMORY, "Failed to deep copy value", 0, 0);
+        }
+        return root;
+    }
+
+    root = value->type == JSON_ARRAY ? json_create_array() : json_create_object();
+    if (!root) goto fail;
+    register_copy(ctx, value, root);
+
+    frames = malloc(TRAVERSAL_STACK_INITIAL * sizeof(CopyFrame));
+    if (!frames) {
+        json_set_error(JSON_ERROR_OUT_OF_MEMORY, "Failed to allocate copy stack", 0, 0);
+        goto fail;
+    }
+    capacity = TRAVERSAL_STACK_INITIAL;
+    frames[depth++] = (CopyFrame){value, root, 0};
+
+    while (depth > 0) {
+        CopyFrame* top = &frames[depth - 1];
+        const JsonValue* child;
+        const char* key = NULL;
+
+        if (top->src->type == JSON_ARRAY) {
+            JsonArray* arr = top->src->data.array_value;
+            if (top->index >= arr->count) {
+                depth--;
+                continue;
+            }
+            child = arr->values[top->index++];
+        } else {
+            JsonObject* obj = top->src->data.object_value;
+            if (top->index >= obj->count) {
+                depth--;
+                continue;
+            }
+            key = obj->pairs[top->index].key;
+            child = obj->pairs[top->index].value;
+            top->index++;
+        }
+
+        JsonValue* child_copy = child ? find_copy(ctx, child) : NULL;
+        bool push_child = false;
+        bool fresh = false;
+
+        if (!child_copy && child) {
+            if (child->type == JSON_ARRAY || child->type == JSON_OBJECT) {
+                child_copy = child->type == JSON_ARRAY ? json_create_array() : json_create_object();
+                push_child = true;
+            } else {
+                child_copy = copy_scalar(child);
+            }
+            if (!child_copy) goto fail;
+            register_copy(ctx, child, child_copy);
+            fresh = true;
+        }
+
+        bool attached = key ? json_object_set(top->dst, key, child_copy)
+                            : json_array_append(top->dst, child_copy);
+        if (!attached) {
+            // An aliased copy is already owned somewhere under root; only a
+            // copy created this iteration needs freeing here
+            if (fresh) json_free(child_copy);
+            goto fail;
+        }
+
+        if (push_child) {
+            if (depth >= capacity) {
+                size_t new_capacity = capacity * 2;
+                CopyFrame* grown = realloc(frames, new_capacity * sizeof(CopyFrame));
+                if (!grown) {
+                    json_set_error(JSON_ERROR_OUT_OF_MEMORY, "Failed to grow copy stack", 0, 0);
+                    goto fail;
+                }
+                frames = grown;
+                capacity = new_capacity;
+            }
+            frames[depth++] = (CopyFrame){child, child_copy, 0};
+        }
+    }
+
+    free(frames);
     free_copy_context(ctx);
-    
-    if (!copy) {
+    return root;
+
+fail:
+    free(frames);
+    free_copy_context(ctx);
+    json_free(root);
+    if (json_get_last_error()->code == JSON_ERROR_NONE) {
         json_set_error(JSON_ERROR_OUT_OF_MEMORY, "Failed to deep copy value", 0, 0);
     }
-    
-    return copy;
+    return NULL;
 }
 
-bool json_equals(const JsonValue* val1, const JsonValue* val2) {
-    if (!val1 && !val2) return true;
-    if (!val1 || !val2) return false;
-    if (val1->type != val2->type) return false;
+typedef struct {
+    const JsonValue* a;
+    const JsonValue* b;
+    size_t index;
+} EqualsFrame;
 
-    switch (val1->type) {
+// Shallow comparison: containers only check type and size here, their
+// children are pushed onto the caller's stack
+static int equals_shallow(const JsonValue* a, const JsonValue* b) {
+    if (!a && !b) return 1;
+    if (!a || !b) return 0;
+    if (a->type != b->type) return 0;
+
+    switch (a->type) {
         case JSON_NULL:
-            return true;
+            return 1;
         case JSON_BOOL:
-            return val1->data.bool_value == val2->data.bool_value;
+            return a->data.bool_value == b->data.bool_value;
         case JSON_NUMBER:
-            return val1->data.number_value == val2->data.number_value;
+            return a->data.number_value == b->data.number_value;
         case JSON_STRING:
-            return strcmp(val1->data.string_value, val2->data.string_value) == 0;
-        case JSON_ARRAY: {
-            JsonArray* arr1 = val1->data.array_value;
-            JsonArray* arr2 = val2->data.array_value;
-            if (arr1->count != arr2->count) return false;
-            for (size_t i = 0; i < arr1->count; i++) {
-                if (!json_equals(arr1->values[i], arr2->values[i])) return false;
+            return strcmp(json_string_value(a), json_string_value(b)) == 0;
+        case JSON_ARRAY:
+            return a->data.array_value->count == b->data.array_value->count ? 2 : 0;
+        case JSON_OBJECT:
+            return a->data.object_value->count == b->data.object_value->count ? 2 : 0;
+    }
+    return 0;
+}
+
+// Iterative: comparison state lives on a heap-backed stack, so deeply
+// nested trees compare without recursion
+bool json_equals(const JsonValue* val1, const JsonValue* val2) {
+    int shallow = equals_shallow(val1, val2);
+    if (shallow != 2) return shallow == 1;
+
+    EqualsFrame* frames = malloc(TRAVERSAL_STACK_INITIAL * sizeof(EqualsFrame));
+    if (!frames) {
+        json_set_error(JSON_ERROR_OUT_OF_MEMORY, "Failed to allocate comparison stack", 0, 0);
+        return false;
+    }
+    size_t capacity = TRAVERSAL_STACK_INITIAL;
+    size_t depth = 0;
+    bool equal = true;
+
+    frames[depth++] = (EqualsFrame){val1, val2, 0};
+
+    while (depth > 0) {
+        EqualsFrame* top = &frames[depth - 1];
+        const JsonValue* child_a;
+        const JsonValue* child_b;
+
+        if (top->a->type == JSON_ARRAY) {
+            JsonArray* arr = top->a->data.array_value;
+            if (top->index >= arr->count) {
+                depth--;
+                continue;
             }
-            return true;
+            child_a = arr->values[top->index];
+            child_b = top->b->data.array_value->values[top->index];
+            top->index++;
+        } else {
+            JsonObject* obj = top->a->data.object_value;
+            if (top->index >= obj->count) {
+                depth--;
+                continue;
+            }
+            child_a = obj->pairs[top->index].value;
+            child_b = json_object_get(top->b, obj->pairs[top->index].key);
+            top->index++;
+            if (!child_b) {
+                equal = false;
+                break;
+            }
+        }
+
+        shallow = equals_shallow(child_a, child_b);
+        if (shallow == 0) {
+            equal = false;
+            break;
         }
-        case JSON_OBJECT: {
-            JsonObject* obj1 = val1->data.object_value;
-            JsonObject* obj2 = val2->data.object_value;
-            if (obj1->count != obj2->count) return false;
-            for (size_t i = 0; i < obj1->count; i++) {
-                JsonValue* val = json_object_get(val2, obj1->pairs[i].key);
-                if (!val || !json_equals(obj1->pairs[i].value, val)) return false;
+        if (shallow == 2) {
+            if (depth >= capacity) {
+                size_t new_capacity = capacity * 2;
+                EqualsFrame* grown = realloc(frames, new_capacity * sizeof(EqualsFrame));
+                if (!grown) {
+                    json_set_error(JSON_ERROR_OUT_OF_MEMORY, "Failed to grow comparison stack", 0, 0);
+                    free(frames);
+                    return false;
+                }
+                frames = grown;
+                capacity = new_capacity;
             }
+            frames[depth++] = (EqualsFrame){child_a, child_b, 0};
+        }
+    }
+
+    free(frames);
+    return equal;
+}
+
+// xxHash-style mixing constants
+#define HASH_PRIME_1 0x9E3779B185EBCA87ULL
+#define HASH_PRIME_2 0xC2B2AE3D27D4EB4FULL
+#define HASH_PRIME_3 0x165667B19E3779F9ULL
+#define HASH_PRIME_4 0x85EBCA77C2B2AE63ULL
+#define HASH_PRIME_5 0x27D4EB2F165667C5ULL
+
+static inline uint64_t hash_rotl(uint64_t x, int r) {
+    return (x << r) | (x >> (64 - r));
+}
+
+static inline uint64_t hash_avalanche(uint64_t h) {
+    h ^= h >> 33;
+    h *= HASH_PRIME_2;
+    h ^= h >> 29;
+    h *= HASH_PRIME_3;
+    h ^= h >> 32;
+    return h;
+}
+
+static uint64_t hash_bytes(const char* data, size_t length) {
+    uint64_t h = HASH_PRIME_5 + length;
+    for (size_t i = 0; i < length; i++) {
+        h ^= (unsigned char)data[i] * HASH_PRIME_5;
+        h = hash_rotl(h, 27) * HASH_PRIME_1 + HASH_PRIME_4;
+    }
+    return hash_avalanche(h);
+}
+
+// Per-type seeds keep e.g. false, null and 0 from colliding
+enum {
+    HASH_TAG_NULL = 1,
+    HASH_TAG_BOOL,
+    HASH_TAG_NUMBER,
+    HASH_TAG_STRING,
+    HASH_TAG_ARRAY,
+    HASH_TAG_OBJECT
+};
+
+static uint64_t hash_scalar(const JsonValue* value) {
+    switch (value->type) {
+        case JSON_NULL:
+            return hash_avalanche(HASH_TAG_NULL * HASH_PRIME_1);
+        case JSON_BOOL:
+            return hash_avalanche(HASH_TAG_BOOL * HASH_PRIME_1
+                                  ^ (value->data.bool_value ? HASH_PRIME_2 : 0));
+        case JSON_NUMBER: {
+            // Normalize -0.0 so values that compare equal hash equal
+            double number = value->data.number_value;
+            if (number == 0.0) number = 0.0;
+            uint64_t bits;
+            memcpy(&bits, &number, sizeof(bits));
+            return hash_avalanche(HASH_TAG_NUMBER * HASH_PRIME_1 ^ bits);
+        }
+        case JSON_STRING: {
+            const char* str = json_string_value(value);
+            return HASH_TAG_STRING * HASH_PRIME_1 ^ hash_bytes(str, strlen(str));
+        }
+        default:
+            return 0;
+    }
+}
+
+// Object pair hashes are combined by addition so key order is irrelevant,
+// matching json_equals; array folds stay order-sensitive
+static inline uint64_t hash_pair(uint64_t key_hash, uint64_t value_hash) {
+    return hash_avalanche(key_hash * HASH_PRIME_1 ^ value_hash * HASH_PRIME_2);
+}
+
+static inline uint64_t hash_fold(uint64_t accum, uint64_t child_hash) {
+    return hash_rotl(accum ^ child_hash * HASH_PRIME_2, 31) * HASH_PRIME_1;
+}
+
+// Pointer-keyed memo of container hashes: probing mirrors the object
+// hash index (power-of-two capacity, load below 1/2)
+typedef struct {
+    const JsonValue* node;
+    uint64_t hash;
+} HashCacheEntry;
+
+struct JsonHashCache {
+    HashCacheEntry* slots;
+    size_t capacity;
+    size_t count;
+};
+
+#define HASH_CACHE_INITIAL_CAPACITY 64
+
+JsonHashCache* json_hash_cache_create(void) {
+    JsonHashCache* cache = malloc(sizeof(JsonHashCache));
+    if (!cache) {
+        json_set_error(JSON_ERROR_OUT_OF_MEMORY, "Failed to allocate hash cache", 0, 0);
+        return NULL;
+    }
+    cache->slots = calloc(HASH_CACHE_INITIAL_CAPACITY, sizeof(HashCacheEntry));
+    if (!cache->slots) {
+        free(cache);
+        json_set_error(JSON_ERROR_OUT_OF_MEMORY, "Failed to allocate hash cache", 0, 0);
+        return NULL;
+    }
+    cache->capacity = HASH_CACHE_INITIAL_CAPACITY;
+    cache->count = 0;
+    return cache;
+}
+
+void json_hash_cache_free(JsonHashCache* cache) {
+    if (!cache) return;
+    free(cache->slots);
+    free(cache);
+}
+
+static inline size_t hash_cache_slot(const JsonHashCache* cache, const JsonValue* node) {
+    return hash_avalanche((uint64_t)(uintptr_t)node) & (cache->capacity - 1);
+}
+
+static bool hash_cache_lookup(const JsonHashCache* cache, const JsonValue* node, uint64_t* out) {
+    size_t slot = hash_cache_slot(cache, node);
+    while (cache->slots[slot].node) {
+        if (cache->slots[slot].node == node) {
+            *out = cache->slots[slot].hash;
             return true;
         }
+        slot = (slot + 1) & (cache->capacity - 1);
     }
     return false;
 }
 
+static void hash_cache_store(JsonHashCache* cache, const JsonValue* node, uint64_t hash) {
+    if (cache->count * 2 >= cache->capacity) {
+        size_t new_capacity = cache->capacity * 2;
+        HashCacheEntry* fresh = calloc(new_capacity, sizeof(HashCacheEntry));
+        if (!fresh) return;  // memo only: dropping an entry costs a recompute
+        for (size_t i = 0; i < cache->capacity; i++) {
+            if (!cache->slots[i].node) continue;
+            size_t slot = hash_avalanche((uint64_t)(uintptr_t)cache->slots[i].node)
+                        & (new_capacity - 1);
+            while (fresh[slot].node) {
+                slot = (slot + 1) & (new_capacity - 1);
+            }
+            fresh[slot] = cache->slots[i];
+        }
+        free(cache->slots);
+        cache->slots = fresh;
+        cache->capacity = new_capacity;
+    }
+
+    size_t slot = hash_cache_slot(cache, node);
+    while (cache->slots[slot].node) {
+        if (cache->slots[slot].node == node) return;
+        slot = (slot + 1) & (cache->capacity - 1);
+    }
+    cache->slots[slot] = (HashCacheEntry){node, hash};
+    cache->count++;
+}
+
+typedef struct {
+    const JsonValue* value;
+    size_t index;
+    uint64_t accum;     // running child fold (array) or pair sum (object)
+    uint64_t key_hash;  // hash of the key this frame sits under, 0 for arrays
+} HashFrame;
+
+static uint64_t hash_finalize(const HashFrame* frame) {
+    if (frame->value->type == JSON_ARRAY) {
+        return hash_avalanche(HASH_TAG_ARRAY * HASH_PRIME_1
+                              ^ frame->accum
+                              ^ frame->value->data.array_value->count * HASH_PRIME_3);
+    }
+    return hash_avalanche(HASH_TAG_OBJECT * HASH_PRIME_1
+                          ^ frame->accum
+                          ^ frame->value->data.object_value->count * HASH_PRIME_3);
+}
+
+// Iterative post-order structural hash; container results are memoized in
+// the cache (when given) so repeated subtree hashes are O(1) after the
+// first full pass
+uint64_t json_hash_cached(const JsonValue* value, JsonHashCache* cache) {
+    if (!value) return 0;
+    if (value->type != JSON_ARRAY && value->type != JSON_OBJECT) {
+        return hash_scalar(value);
+    }
+
+    uint64_t cached;
+    if (cache && hash_cache_lookup(cache, value, &cached)) {
+        return cached;
+    }
+
+    HashFrame* frames = malloc(TRAVERSAL_STACK_INITIAL * sizeof(HashFrame));
+    if (!frames) {
+        json_set_error(JSON_ERROR_OUT_OF_MEMORY, "Failed to allocate hash stack", 0, 0);
+        return 0;
+    }
+    size_t capacity = TRAVERSAL_STACK_INITIAL;
+    size_t depth = 0;
+    uint64_t result = 0;
+
+    frames[depth++] = (HashFrame){value, 0, 0, 0};
+
+    while (depth > 0) {
+        HashFrame* top = &frames[depth - 1];
+        const JsonValue* child = NULL;
+        uint64_t key_hash = 0;
+        bool done;
+
+        if (top->value->type == JSON_ARRAY) {
+            JsonArray* arr = top->value->data.array_value;
+            done = top->index >= arr->count;
+            if (!done) child = arr->values[top->index++];
+        } else {
+            JsonObject* obj = top->value->data.object_value;
+            done = top->index >= obj->count;
+            if (!done) {
+                key_hash = hash_bytes(obj->pairs[top->index].key,
+                                      strlen(obj->pairs[top->index].key));
+                child = obj->pairs[top->index].value;
+                top->index++;
+            }
+        }
+
+        if (done) {
+            result = hash_finalize(top);
+            if (cache) hash_cache_store(cache, top->value, result);
+            uint64_t frame_key = top->key_hash;
+            depth--;
+            if (depth > 0) {
+                HashFrame* parent = &frames[depth - 1];
+                if (parent->value->type == JSON_OBJECT) {
+                    parent->accum += hash_pair(frame_key, result);
+                } else {
+                    parent->accum = hash_fold(parent->accum, result);
+                }
+            }
+            continue;
+        }
+
+        uint64_t child_hash;
+        if (!child) {
+            child_hash = 0;  // detached slot (the move APIs leave these)
+        } else if (child->type != JSON_ARRAY && child->type != JSON_OBJECT) {
+            child_hash = hash_scalar(child);
+        } else if (cache && hash_cache_lookup(cache, child, &child_hash)) {
+            // memoized container
+        } else {
+            if (depth >= capacity) {
+                size_t new_capacity = capacity * 2;
+                HashFrame* grown = realloc(frames, new_capacity * sizeof(HashFrame));
+                if (!grown) {
+                    json_set_error(JSON_ERROR_OUT_OF_MEMORY, "Failed to grow hash stack", 0, 0);
+                    free(frames);
+                    return 0;
+                }
+                frames = grown;
+                capacity = new_capacity;
+            }
+            frames[depth++] = (HashFrame){child, 0, 0, key_hash};
+            continue;
+        }
+
+        if (top->value->type == JSON_OBJECT) {
+            top->accum += hash_pair(key_hash, child_hash);
+        } else {
+            top->accum = hash_fold(top->accum, child_hash);
+        }
+    }
+
+    free(frames);
+    return result;
+}
+
+uint64_t json_hash(const JsonValue* value) {
+    return json_hash_cached(value, NULL);
+}
+
 JsonValue* json_merge(const JsonValue* obj1, const JsonValue* obj2) {
     if (!obj1 || !obj2) {
         json_set_error(JSON_ERROR_NULL_POINTER, "Cannot merge NULL objects", 0, 0);
@@ -200,3 +601,58 @@ JsonValue* json_merge(const JsonValue* obj1, const JsonValue* obj2) {
 
     return result;
 }
+
+// Moving merge: obj2's members are re-parented into obj1 by pointer,
+// then obj2's shell is freed. Consumes obj2 (on success and on failure);
+// obj1 may hold a partial merge if an allocation fails mid-way.
+JsonValue* json_merge_move(JsonValue* obj1, JsonValue* obj2) {
+    if (!obj1 || !obj2) {
+        json_set_error(JSON_ERROR_NULL_POINTER, "Cannot merge NULL objects", 0, 0);
+        return NULL;
+    }
+
+    if (obj1->type != JSON_OBJECT || obj2->type != JSON_OBJECT) {
+        json_set_error(JSON_ERROR_INVALID_TYPE, "Can only merge JSON objects", 0, 0);
+        return NULL;
+    }
+
+    JsonObject* src = obj2->data.object_value;
+
+    for (size_t i = 0; i < src->count; i++) {
+        if (!json_object_set(obj1, src->pairs[i].key, src->pairs[i].value)) {
+            json_free(obj2);
+            return NULL;
+        }
+        src->pairs[i].value = NULL;
+    }
+
+    json_free(obj2);
+    return obj1;
+}
+
+// Append every element of src to dst by pointer, then free src's shell.
+// Consumes src (on success and on failure).
+bool json_array_concat_move(JsonValue* dst, JsonValue* src) {
+    if (!dst || !src) {
+        json_set_error(JSON_ERROR_NULL_POINTER, "Cannot concatenate NULL arrays", 0, 0);
+        return false;
+    }
+
+    if (dst->type != JSON_ARRAY || src->type != JSON_ARRAY) {
+        json_set_error(JSON_ERROR_INVALID_TYPE, "Can only concatenate JSON arrays", 0, 0);
+        return false;
+    }
+
+    JsonArray* s = src->data.array_value;
+
+    for (size_t i = 0; i < s->count; i++) {
+        if (!json_array_append(dst, s->values[i])) {
+            json_free(src);
+            return false;
+        }
+        s->values[i] = NULL;
+    }
+
+    json_free(src);
+    return true;
+}
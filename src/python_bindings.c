@@ -1,5 +1,6 @@
 #define PY_SSIZE_T_CLEAN
 #include <Python.h>
+#include <pthread.h>
 #include "json_parser.h"
 
 static void json_value_destructor(PyObject* capsule) {
@@ -27,7 +28,10 @@ static PyObject* py_parse(PyObject* self, PyObject* args) {
         return NULL;
     }
     
-    JsonValue* value = json_parse(json_string);
+    JsonValue* value;
+    Py_BEGIN_ALLOW_THREADS
+    value = json_parse(json_string);
+    Py_END_ALLOW_THREADS
     if (!value) {
         JsonError* error = json_get_last_error();
         char error_msg[1024];
@@ -66,7 +70,10 @@ static PyObject* py_stringify(PyObject* self, PyObject* args) {
         return NULL;
     }
     
-    char* result = json_stringify(value, pretty);
+    char* result;
+    Py_BEGIN_ALLOW_THREADS
+    result = json_stringify(value, pretty);
+    Py_END_ALLOW_THREADS
     if (!result) {
         JsonError* error = json_get_last_error();
         char error_msg[1024];
@@ -103,7 +110,10 @@ static PyObject* py_to_xml(PyObject* self, PyObject* args) {
         return NULL;
     }
     
-    char* result = json_to_xml(value);
+    char* result;
+    Py_BEGIN_ALLOW_THREADS
+    result = json_to_xml(value);
+    Py_END_ALLOW_THREADS
     if (!result) {
         JsonError* error = json_get_last_error();
         char error_msg[1024];
@@ -140,7 +150,10 @@ static PyObject* py_to_yaml(PyObject* self, PyObject* args) {
         return NULL;
     }
     
-    char* result = json_to_yaml(value);
+    char* result;
+    Py_BEGIN_ALLOW_THREADS
+    result = json_to_yaml(value);
+    Py_END_ALLOW_THREADS
     if (!result) {
         JsonError* error = json_get_last_error();
         char error_msg[1024];
@@ -172,7 +185,10 @@ static PyObject* py_to_csv(PyObject* self, PyObject* args) {
         return NULL;
     }
     
-    char* result = json_to_csv(value);
+    char* result;
+    Py_BEGIN_ALLOW_THREADS
+    result = json_to_csv(value);
+    Py_END_ALLOW_THREADS
     if (!result) {
         PyErr_SetString(PyExc_ValueError, "Cannot convert to CSV");
         return NULL;
@@ -196,7 +212,10 @@ static PyObject* py_to_ini(PyObject* self, PyObject* args) {
         return NULL;
     }
     
-    char* result = json_to_ini(value);
+    char* result;
+    Py_BEGIN_ALLOW_THREADS
+    result = json_to_ini(value);
+    Py_END_ALLOW_THREADS
     if (!result) {
         PyErr_SetString(PyExc_ValueError, "Cannot convert to INI");
         return NULL;
@@ -214,7 +233,10 @@ static PyObject* py_validate(PyObject* self, PyObject* args) {
         return NULL;
     }
     
-    bool valid = json_validate(json_string);
+    bool valid;
+    Py_BEGIN_ALLOW_THREADS
+    valid = json_validate(json_string);
+    Py_END_ALLOW_THREADS
     return PyBool_FromLong(valid);
 }
 
@@ -243,7 +265,10 @@ static PyObject* py_parse_file(PyObject* self, PyObject* args) {
         return NULL;
     }
     
-    JsonValue* value = json_parse_file(filename);
+    JsonValue* value;
+    Py_BEGIN_ALLOW_THREADS
+    value = json_parse_file(filename);
+    Py_END_ALLOW_THREADS
     if (!value) {
         JsonError* error = json_get_last_error();
         char error_msg[1024];
@@ -287,7 +312,10 @@ static PyObject* py_save_file(PyObject* self, PyObject* args) {
         return NULL;
     }
     
-    bool success = json_save_file(filename, value, pretty);
+    bool success;
+    Py_BEGIN_ALLOW_THREADS
+    success = json_save_file(filename, value, pretty);
+    Py_END_ALLOW_THREADS
     if (!success) {
         JsonError* error = json_get_last_error();
         char error_msg[1024];
@@ -303,7 +331,10 @@ static PyObject* py_xml_to_json(PyObject* self, PyObject* args) {
     const char* xml;
     if (!PyArg_ParseTuple(args, "s", &xml)) return NULL;
     
-    JsonValue* value = xml_to_json(xml);
+    JsonValue* value;
+    Py_BEGIN_ALLOW_THREADS
+    value = xml_to_json(xml);
+    Py_END_ALLOW_THREADS
     if (!value) {
         PyErr_SetString(PyExc_ValueError, "Invalid XML");
         return NULL;
@@ -316,7 +347,10 @@ static PyObject* py_yaml_to_json(PyObject* self, PyObject* args) {
     const char* yaml;
     if (!PyArg_ParseTuple(args, "s", &yaml)) return NULL;
     
-    JsonValue* value = yaml_to_json(yaml);
+    JsonValue* value;
+    Py_BEGIN_ALLOW_THREADS
+    value = yaml_to_json(yaml);
+    Py_END_ALLOW_THREADS
     if (!value) {
         PyErr_SetString(PyExc_ValueError, "Invalid YAML");
         return NULL;
@@ -329,7 +363,10 @@ static PyObject* py_csv_to_json(PyObject* self, PyObject* args) {
     const char* csv;
     if (!PyArg_ParseTuple(args, "s", &csv)) return NULL;
     
-    JsonValue* value = csv_to_json(csv);
+    JsonValue* value;
+    Py_BEGIN_ALLOW_THREADS
+    value = csv_to_json(csv);
+    Py_END_ALLOW_THREADS
     if (!value) {
         PyErr_SetString(PyExc_ValueError, "Invalid CSV");
         return NULL;
@@ -342,7 +379,10 @@ static PyObject* py_ini_to_json(PyObject* self, PyObject* args) {
     const char* ini;
     if (!PyArg_ParseTuple(args, "s", &ini)) return NULL;
     
-    JsonValue* value = ini_to_json(ini);
+    JsonValue* value;
+    Py_BEGIN_ALLOW_THREADS
+    value = ini_to_json(ini);
+    Py_END_ALLOW_THREADS
     if (!value) {
         PyErr_SetString(PyExc_ValueError, "Invalid INI");
         return NULL;
@@ -363,7 +403,10 @@ static PyObject* py_to_sqlite(PyObject* self, PyObject* args) {
         return NULL;
     }
     
-    JsonSqliteDB* db = json_to_sqlite(value, db_path);
+    JsonSqliteDB* db;
+    Py_BEGIN_ALLOW_THREADS
+    db = json_to_sqlite(value, db_path);
+    Py_END_ALLOW_THREADS
     if (!db) {
         PyErr_SetString(PyExc_IOError, "Cannot create SQLite database");
         return NULL;
@@ -382,7 +425,10 @@ static PyObject* py_sqlite_insert(PyObject* self, PyObject* args) {
     JsonSqliteDB* db = (JsonSqliteDB*)PyCapsule_GetPointer(db_capsule, "JsonSqliteDB");
     JsonValue* value = (JsonValue*)PyCapsule_GetPointer(value_capsule, "JsonValue");
     
-    bool success = sqlite_insert(db, table, value);
+    bool success;
+    Py_BEGIN_ALLOW_THREADS
+    success = sqlite_insert(db, table, value);
+    Py_END_ALLOW_THREADS
     return PyBool_FromLong(success);
 }
 
@@ -395,7 +441,10 @@ static PyObject* py_sqlite_query(PyObject* self, PyObject* args) {
     if (!PyArg_ParseTuple(args, "Osss", &db_capsule, &table, &key, &value)) return NULL;
     
     JsonSqliteDB* db = (JsonSqliteDB*)PyCapsule_GetPointer(db_capsule, "JsonSqliteDB");
-    JsonValue* result = sqlite_query(db, table, key, value);
+    JsonValue* result;
+    Py_BEGIN_ALLOW_THREADS
+    result = sqlite_query(db, table, key, value);
+    Py_END_ALLOW_THREADS
     
     return (PyObject*)PyCapsule_New(result, "JsonValue", json_value_destructor);
 }
@@ -424,6 +473,113 @@ static PyObject* py_path_query(PyObject* self, PyObject* args) {
     return (PyObject*)PyCapsule_New(result, "JsonValue", json_value_destructor);
 }
 
+// Batch entry points: one binding call for many documents/paths, so
+// tight Python loops pay the FFI and GIL cost once instead of per item.
+
+static PyObject* py_parse_many(PyObject* self, PyObject* args) {
+    PyObject* strings;
+    if (!PyArg_ParseTuple(args, "O", &strings)) return NULL;
+
+    PyObject* seq = PySequence_Fast(strings, "parse_many expects a sequence of strings");
+    if (!seq) return NULL;
+
+    Py_ssize_t count = PySequence_Fast_GET_SIZE(seq);
+    PyObject* results = PyList_New(count);
+    if (!results) {
+        Py_DECREF(seq);
+        return NULL;
+    }
+
+    for (Py_ssize_t i = 0; i < count; i++) {
+        PyObject* item = PySequence_Fast_GET_ITEM(seq, i);
+        const char* json_string = PyUnicode_AsUTF8(item);
+        if (!json_string) {
+            Py_DECREF(results);
+            Py_DECREF(seq);
+            return NULL;
+        }
+
+        JsonValue* value;
+        Py_BEGIN_ALLOW_THREADS
+        value = json_parse(json_string);
+        Py_END_ALLOW_THREADS
+        if (!value) {
+            JsonError* error = json_get_last_error();
+            char error_msg[1024];
+            snprintf(error_msg, sizeof(error_msg),
+                     "JSON Parse Error in document %zd at line %zu, column %zu: %s",
+                     i, error->line, error->column, error->message);
+            PyErr_SetString(PyExc_ValueError, error_msg);
+            Py_DECREF(results);
+            Py_DECREF(seq);
+            return NULL;
+        }
+
+        PyObject* capsule = PyCapsule_New(value, "JsonValue", json_value_destructor);
+        if (!capsule) {
+            json_free(value);
+            Py_DECREF(results);
+            Py_DECREF(seq);
+            return NULL;
+        }
+        PyList_SET_ITEM(results, i, capsule);
+    }
+
+    Py_DECREF(seq);
+    return results;
+}
+
+static PyObject* py_path_query_many(PyObject* self, PyObject* args) {
+    PyObject* capsule;
+    PyObject* paths;
+    if (!PyArg_ParseTuple(args, "OO", &capsule, &paths)) return NULL;
+
+    JsonValue* root = (JsonValue*)PyCapsule_GetPointer(capsule, "JsonValue");
+    if (!root) {
+        PyErr_SetString(PyExc_ValueError, "Invalid JSON value");
+        return NULL;
+    }
+
+    PyObject* seq = PySequence_Fast(paths, "path_query_many expects a sequence of paths");
+    if (!seq) return NULL;
+
+    Py_ssize_t count = PySequence_Fast_GET_SIZE(seq);
+    PyObject* results = PyList_New(count);
+    if (!results) {
+        Py_DECREF(seq);
+        return NULL;
+    }
+
+    for (Py_ssize_t i = 0; i < count; i++) {
+        PyObject* item = PySequence_Fast_GET_ITEM(seq, i);
+        const char* path = PyUnicode_AsUTF8(item);
+        if (!path) {
+            Py_DECREF(results);
+            Py_DECREF(seq);
+            return NULL;
+        }
+
+        JsonValue* match = json_path_query(root, path);
+        if (!match) {
+            Py_INCREF(Py_None);
+            PyList_SET_ITEM(results, i, Py_None);
+            continue;
+        }
+
+        PyObject* match_capsule = PyCapsule_New(match, "JsonValue", json_value_destructor);
+        if (!match_capsule) {
+            json_free(match);
+            Py_DECREF(results);
+            Py_DECREF(seq);
+            return NULL;
+        }
+        PyList_SET_ITEM(results, i, match_capsule);
+    }
+
+    Py_DECREF(seq);
+    return results;
+}
+
 static PyObject* py_get_last_error(PyObject* self, PyObject* args) {
     JsonError* error = json_get_last_error();
     
@@ -630,6 +786,22 @@ static PyObject* py_diff(PyObject* self, PyObject* args) {
     return (PyObject*)PyCapsule_New(diff, "JsonValue", json_value_destructor);
 }
 
+static PyObject* py_diff_deep(PyObject* self, PyObject* args) {
+    PyObject* capsule1;
+    PyObject* capsule2;
+    
+    if (!PyArg_ParseTuple(args, "OO", &capsule1, &capsule2)) return NULL;
+    
+    JsonValue* val1 = (JsonValue*)PyCapsule_GetPointer(capsule1, "JsonValue");
+    JsonValue* val2 = (JsonValue*)PyCapsule_GetPointer(capsule2, "JsonValue");
+    
+    JsonValue* diff;
+    Py_BEGIN_ALLOW_THREADS
+    diff = json_diff_deep(val1, val2);
+    Py_END_ALLOW_THREADS
+    return (PyObject*)PyCapsule_New(diff, "JsonValue", json_value_destructor);
+}
+
 static PyObject* py_patch(PyObject* self, PyObject* args) {
     PyObject* target_capsule;
     PyObject* patch_capsule;
@@ -1032,7 +1204,7 @@ static PyObject* json_value_to_python_helper(JsonValue* value) {
         case JSON_NUMBER:
             return PyFloat_FromDouble(value->data.number_value);
         case JSON_STRING:
-            return PyUnicode_FromString(value->data.string_value);
+            return PyUnicode_FromString(json_string_value(value));
         case JSON_ARRAY: {
             JsonArray* arr = value->data.array_value;
             PyObject* py_list = PyList_New(arr->count);
@@ -1245,7 +1417,10 @@ static PyObject* py_sqlite_get_all(PyObject* self, PyObject* args) {
     if (!PyArg_ParseTuple(args, "Os", &db_capsule, &table)) return NULL;
     
     JsonSqliteDB* db = (JsonSqliteDB*)PyCapsule_GetPointer(db_capsule, "JsonSqliteDB");
-    JsonValue* result = sqlite_get_all(db, table);
+    JsonValue* result;
+    Py_BEGIN_ALLOW_THREADS
+    result = sqlite_get_all(db, table);
+    Py_END_ALLOW_THREADS
     
     if (!result) {
         PyErr_SetString(PyExc_RuntimeError, "Failed to query table");
@@ -1267,7 +1442,10 @@ static PyObject* py_sqlite_update(PyObject* self, PyObject* args) {
     JsonSqliteDB* db = (JsonSqliteDB*)PyCapsule_GetPointer(db_capsule, "JsonSqliteDB");
     JsonValue* new_data = (JsonValue*)PyCapsule_GetPointer(new_data_capsule, "JsonValue");
     
-    bool success = sqlite_update(db, table, key, key_value, new_data);
+    bool success;
+    Py_BEGIN_ALLOW_THREADS
+    success = sqlite_update(db, table, key, key_value, new_data);
+    Py_END_ALLOW_THREADS
     return PyBool_FromLong(success);
 }
 
@@ -1281,7 +1459,10 @@ static PyObject* py_sqlite_delete(PyObject* self, PyObject* args) {
     
     JsonSqliteDB* db = (JsonSqliteDB*)PyCapsule_GetPointer(db_capsule, "JsonSqliteDB");
     
-    bool success = sqlite_delete(db, table, key, value);
+    bool success;
+    Py_BEGIN_ALLOW_THREADS
+    success = sqlite_delete(db, table, key, value);
+    Py_END_ALLOW_THREADS
     return PyBool_FromLong(success);
 }
 
@@ -1290,13 +1471,170 @@ static PyObject* py_sqlite_optimize(PyObject* self, PyObject* args) {
     if (!PyArg_ParseTuple(args, "O", &capsule)) return NULL;
     
     JsonSqliteDB* db = (JsonSqliteDB*)PyCapsule_GetPointer(capsule, "JsonSqliteDB");
-    if (db) sqlite_optimize(db);
+    if (db) {
+        Py_BEGIN_ALLOW_THREADS
+        sqlite_optimize(db);
+        Py_END_ALLOW_THREADS
+    }
     
     Py_RETURN_NONE;
 }
 
+// parse_async: parse on a background thread while the caller keeps the GIL.
+// The returned capsule is a one-shot future; future_result() joins the worker
+// and hands back the parsed tree (or raises the worker's parse error).
+typedef struct {
+    pthread_t thread;
+    pthread_mutex_t lock;  // serializes the join when the GIL is released
+    char* input;           // owned copy of the JSON text
+    JsonValue* result;     // set by the worker on success
+    JsonError error;       // copy of the worker's thread-local error on failure
+    bool joined;
+} JsonParseFuture;
+
+static void* parse_future_worker(void* arg) {
+    JsonParseFuture* future = (JsonParseFuture*)arg;
+    future->result = json_parse(future->input);
+    if (!future->result) {
+        future->error = *json_get_last_error();
+    }
+    return NULL;
+}
+
+static void parse_future_destructor(PyObject* capsule) {
+    JsonParseFuture* future = (JsonParseFuture*)PyCapsule_GetPointer(capsule, "JsonParseFuture");
+    if (!future) return;
+
+    if (!future->joined) {
+        pthread_join(future->thread, NULL);
+    }
+    pthread_mutex_destroy(&future->lock);
+    if (future->result) {
+        json_free(future->result);
+    }
+    free(future->input);
+    free(future);
+}
+
+static PyObject* py_parse_async(PyObject* self, PyObject* args) {
+    const char* json_string;
+    if (!PyArg_ParseTuple(args, "s", &json_string)) {
+        return NULL;
+    }
+
+    JsonParseFuture* future = calloc(1, sizeof(JsonParseFuture));
+    if (!future) {
+        PyErr_NoMemory();
+        return NULL;
+    }
+
+    size_t len = strlen(json_string) + 1;
+    future->input = malloc(len);
+    if (!future->input) {
+        free(future);
+        PyErr_NoMemory();
+        return NULL;
+    }
+    memcpy(future->input, json_string, len);
+    pthread_mutex_init(&future->lock, NULL);
+
+    if (pthread_create(&future->thread, NULL, parse_future_worker, future) != 0) {
+        pthread_mutex_destroy(&future->lock);
+        free(future->input);
+        free(future);
+        PyErr_SetString(PyExc_RuntimeError, "Failed to start parse worker thread");
+        return NULL;
+    }
+
+    PyObject* capsule = PyCapsule_New(future, "JsonParseFuture", parse_future_destructor);
+    if (!capsule) {
+        pthread_join(future->thread, NULL);
+        pthread_mutex_destroy(&future->lock);
+        if (future->result) json_free(future->result);
+        free(future->input);
+        free(future);
+        PyErr_SetString(PyExc_RuntimeError, "Failed to create Python capsule");
+        return NULL;
+    }
+
+    return capsule;
+}
+
+static PyObject* py_future_result(PyObject* self, PyObject* args) {
+    PyObject* capsule;
+    if (!PyArg_ParseTuple(args, "O", &capsule)) {
+        return NULL;
+    }
+
+    JsonParseFuture* future = (JsonParseFuture*)PyCapsule_GetPointer(capsule, "JsonParseFuture");
+    if (!future) {
+        PyErr_SetString(PyExc_TypeError, "Argument must be a valid JsonParseFuture capsule");
+        return NULL;
+    }
+
+    // The join runs without the GIL, so the joined check-and-set must be
+    // under the future's own lock or two callers would both join the worker
+    Py_BEGIN_ALLOW_THREADS
+    pthread_mutex_lock(&future->lock);
+    if (!future->joined) {
+        pthread_join(future->thread, NULL);
+        future->joined = true;
+    }
+    pthread_mutex_unlock(&future->lock);
+    Py_END_ALLOW_THREADS
+
+    if (!future->result) {
+        if (future->error.code != JSON_ERROR_NONE) {
+            char error_msg[1024];
+            snprintf(error_msg, sizeof(error_msg), "JSON Parse Error at line %zu, column %zu: %s",
+                     future->error.line, future->error.column, future->error.message);
+            PyErr_SetString(PyExc_ValueError, error_msg);
+        } else {
+            PyErr_SetString(PyExc_RuntimeError, "Future result already consumed");
+        }
+        return NULL;
+    }
+
+    PyObject* result = PyCapsule_New(future->result, "JsonValue", json_value_destructor);
+    if (!result) {
+        PyErr_SetString(PyExc_RuntimeError, "Failed to create Python capsule");
+        return NULL;
+    }
+
+    future->result = NULL;  // ownership transferred to the capsule
+    return result;
+}
+
+static PyObject* py_get_stats(PyObject* self, PyObject* args) {
+    (void)self;
+    (void)args;
+    JsonStats stats;
+    json_get_stats(&stats);
+    return Py_BuildValue("{s:K,s:K,s:K,s:K,s:K,s:K,s:K,s:K}",
+        "bytes_tokenized", (unsigned long long)stats.bytes_tokenized,
+        "values_allocated", (unsigned long long)stats.values_allocated,
+        "whitespace_simd_chunks", (unsigned long long)stats.whitespace_simd_chunks,
+        "whitespace_scalar_bytes", (unsigned long long)stats.whitespace_scalar_bytes,
+        "object_lookups", (unsigned long long)stats.object_lookups,
+        "object_scan_steps", (unsigned long long)stats.object_scan_steps,
+        "stringify_grow_blocks", (unsigned long long)stats.stringify_grow_blocks,
+        "stream_buffer_high_water", (unsigned long long)stats.stream_buffer_high_water);
+}
+
+static PyObject* py_reset_stats(PyObject* self, PyObject* args) {
+    (void)self;
+    (void)args;
+    json_reset_stats();
+    Py_RETURN_NONE;
+}
+
 static PyMethodDef JsonMethods[] = {
     {"parse", py_parse, METH_VARARGS, "Parse JSON string"},
+    {"parse_many", py_parse_many, METH_VARARGS, "Parse a sequence of JSON strings in one call"},
+    {"parse_async", py_parse_async, METH_VARARGS, "Parse JSON on a background thread, returns a future"},
+    {"future_result", py_future_result, METH_VARARGS, "Wait for a parse_async future and return its value"},
+    {"get_stats", py_get_stats, METH_NOARGS, "Per-thread hot-path counters (zeros unless built with CJSON_STATS)"},
+    {"reset_stats", py_reset_stats, METH_NOARGS, "Reset this thread's hot-path counters"},
     {"parse_file", py_parse_file, METH_VARARGS, "Parse JSON from file"},
     {"save_file", py_save_file, METH_VARARGS, "Save JSON to file"},
     {"stringify", py_stringify, METH_VARARGS, "Convert JSON to string"},
@@ -1317,6 +1655,7 @@ static PyMethodDef JsonMethods[] = {
     {"sqlite_optimize", py_sqlite_optimize, METH_VARARGS, "Optimize SQLite database"},
     {"sqlite_close", py_sqlite_close, METH_VARARGS, "Close SQLite database"},
     {"path_query", py_path_query, METH_VARARGS, "Query JSON using path"},
+    {"path_query_many", py_path_query_many, METH_VARARGS, "Run several path queries against one document"},
     {"validate", py_validate, METH_VARARGS, "Validate JSON string"},
     {"get_last_error", py_get_last_error, METH_VARARGS, "Get last error details"},
     {"clear_error", py_clear_error, METH_VARARGS, "Clear error state"},
@@ -1335,6 +1674,7 @@ static PyMethodDef JsonMethods[] = {
     {"optimize_memory", py_optimize_memory, METH_VARARGS, "Optimize memory usage"},
     {"validate_schema", py_validate_schema, METH_VARARGS, "Validate against schema"},
     {"diff", py_diff, METH_VARARGS, "Get difference between values"},
+    {"diff_deep", py_diff_deep, METH_VARARGS, "Per-path diff, skipping unchanged subtrees by hash"},
     {"patch", py_patch, METH_VARARGS, "Apply patch to value"},
     {"stream_parse_chunk", py_stream_parse_chunk, METH_VARARGS, "Parse JSON chunk in streaming mode"},
     {"stream_parse_file", py_stream_parse_file, METH_VARARGS, "Parse JSON file in streaming mode"},
@@ -1349,6 +1689,7 @@ static PyMethodDef JsonMethods[] = {
     {"object_get", py_object_get, METH_VARARGS, "Get object value by key"},
     {"get_type", py_get_type, METH_VARARGS, "Get JSON value type"},
     {"to_python", py_to_python, METH_VARARGS, "Convert JSON to Python object"},
+    {"to_native", py_to_python, METH_VARARGS, "Convert an entire JSON tree to native Python objects in one traversal"},
     {"from_python", py_from_python, METH_VARARGS, "Convert Python object to JSON"},
     {"free", py_free, METH_VARARGS, "Free JSON value"},
     {NULL, NULL, 0, NULL}